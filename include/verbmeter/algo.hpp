@@ -20,6 +20,8 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #pragma once
 
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <string>
 
@@ -46,8 +48,118 @@ int gen2ElementVariations(
     std::vector<std::pair<std::string const *, std::string const *>>
         *const combinations);
 
+/* DESCRIPTION:
+ *
+ * For each occurrence of A that is the last one before an occurrence of B,
+ * stores the distance to that occurrence of B. The last occurrence of A
+ * wraps around the end of the text to the first occurrence of B.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'posA' argument is a nullptr.
+ *
+ * 2 - The 'posB' argument is a nullptr.
+ *
+ * 3 - The 'out' argument is a nullptr.
+ */
 int computeSinglePairDistances(std::vector<std::size_t> const *const posA,
                                std::vector<std::size_t> const *const posB,
                                std::size_t const totalWordCount,
                                std::vector<std::size_t> *const out);
+
+/* DESCRIPTION:
+ *
+ * Reads the positions in place, e.g. from a mapped file.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 3 - The 'out' argument is a nullptr.
+ */
+int computeSinglePairDistances(std::span<std::size_t const> const posA,
+                               std::span<std::size_t const> const posB,
+                               std::size_t const totalWordCount,
+                               std::vector<std::size_t> *const out);
+
+/* DESCRIPTION:
+ *
+ * Restricts the stored distances to those not greater than 'maxDistance'.
+ * If 'wrapAround' is false, the distance wrapping around the end
+ * of the text is never stored. A 'maxDistance' of 0 means no limit.
+ */
+struct DistanceWindowT {
+  std::size_t maxDistance{};
+  bool wrapAround{true};
+};
+
+/* DESCRIPTION:
+ *
+ * Returns false if no distance of the pair can fall within the window,
+ * judging only by the first and last occurrences, in constant time.
+ */
+bool pairWithinReach(std::span<std::size_t const> const posA,
+                     std::span<std::size_t const> const posB,
+                     std::size_t const totalWordCount,
+                     DistanceWindowT const &window);
+
+/* DESCRIPTION:
+ *
+ * Stores the distances computeSinglePairDistances would store
+ * that fall within the window. Instead of searching the whole lists
+ * for every occurrence, the searches gallop forward from the previous
+ * match, and the kernel stops as soon as no further occurrence of B
+ * can follow. Pairs that cannot reach the window are not traversed.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'out' argument is a nullptr.
+ */
+int computeWindowedPairDistances(std::span<std::size_t const> const posA,
+                                 std::span<std::size_t const> const posB,
+                                 std::size_t const totalWordCount,
+                                 DistanceWindowT const &window,
+                                 std::vector<std::size_t> *const out);
+
+struct DistanceSampleT {
+  double distanceAvg{};
+  double confidence{};
+  std::size_t sampledCount{};
+};
+
+/* DESCRIPTION:
+ *
+ * Estimates the distances computeSinglePairDistances would store
+ * from at most 'sampleBudget' occurrences of A. The occurrences are split
+ * into 'sampleBudget' equal strata and one random occurrence is drawn
+ * from each of them, so the runtime is bounded by the budget.
+ * The distances of the drawn occurrences that would have been stored
+ * are written into 'out'. 'sample' receives their average and
+ * the half-width of its 95% confidence interval.
+ * Equal seeds draw equal samples. If A has no more occurrences than
+ * the budget, the result is exact and the confidence is 0.
+ * Only the distances within the window are kept.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'out' argument is a nullptr.
+ *
+ * 2 - The 'sample' argument is a nullptr.
+ *
+ * 3 - The 'sampleBudget' argument is equal to 0.
+ */
+int sampleSinglePairDistances(std::span<std::size_t const> const posA,
+                              std::span<std::size_t const> const posB,
+                              std::size_t const totalWordCount,
+                              std::size_t const sampleBudget,
+                              std::uint64_t const seed,
+                              std::vector<std::size_t> *const out,
+                              DistanceSampleT *const sample,
+                              DistanceWindowT const &window = {});
 } // namespace al
@@ -20,8 +20,11 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace qy {
@@ -40,6 +43,96 @@ void destroyDatabase(Database const);
 using UniqueDatabase = std::unique_ptr<DatabaseT, void (*)(Database const)>;
 UniqueDatabase createUniqueDatabase();
 
+/* DESCRIPTION:
+ *
+ * Selects how queryFile ingests a file. The sequential ingestion reads
+ * the file twice on the calling thread, once to count the words and once
+ * to store their positions. The pipelined ingestion reads the file once,
+ * overlapping reading, tokenizing and indexing on separate threads.
+ * Both yield the same database.
+ */
+enum class IngestionE { Sequential, Pipelined };
+
+/* DESCRIPTION:
+ *
+ * Must be called before queryFile.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ */
+int setIngestion(Database const db, IngestionE const ingestion);
+
+/* DESCRIPTION:
+ *
+ * Selects the tokens that are indexed by queryFile. A token is indexed
+ * only if it is not a stop word, its length is within
+ * [minLength, maxLength], it is on the allow list and the predicate
+ * accepts it. An empty list, a 0 length or an empty predicate
+ * disables the respective check. The words and tokens are compared
+ * lowercased, stripped of everything but letters.
+ *
+ * If 'allowListPositionsOnly' is set, the allow list does not filter
+ * the tokens. Every word is counted, but the positions are only
+ * tracked for the allowed ones. With an empty allow list the words are
+ * only counted, which the sequential ingestion does in a single pass.
+ */
+struct TokenFilterT {
+  std::vector<std::string> stopWords{};
+  std::size_t minLength{};
+  std::size_t maxLength{};
+  std::vector<std::string> allowList{};
+  bool allowListPositionsOnly{};
+  std::function<bool(std::string_view)> predicate{};
+};
+
+/* DESCRIPTION:
+ *
+ * Must be called before queryFile.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'minLength' is greater than the 'maxLength'.
+ */
+int setTokenFilter(Database const db, TokenFilterT const &filter);
+
+/* DESCRIPTION:
+ *
+ * Limits the memory held by the word positions to about 'bytes'.
+ * Once the positions exceed the budget, they are spilled into
+ * temporary files within 'tmpDir' and merged per word after
+ * the file has been read. The positions are then read back from disk.
+ * If 'bytes' is equal to 0, all the positions are kept in memory.
+ * If 'tmpDir' is empty, the system temporary directory is used.
+ * Must be called before queryFile.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'tmpDir' argument is not a directory.
+ */
+int setMemoryBudget(Database const db, std::size_t const bytes,
+                    std::string const &tmpDir = "");
+
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'bytes' argument is a nullptr.
+ */
+int getMemoryBudget(Database const db, std::size_t *const bytes);
+
 /* EXIT STATUS:
  *
  * 0 - The operation was successful.
@@ -51,6 +144,10 @@ UniqueDatabase createUniqueDatabase();
  * 3 - Gathering word positions failed.
  *
  * 4 - Sorting the words, most common first, failed.
+ *
+ * The pipelined ingestion counts the words and gathers their positions
+ * in one step, its failures are reported as 2 if the file could not be
+ * read and as 3 otherwise.
  */
 int queryFile(Database const db, std::string const &file);
 
@@ -86,6 +183,42 @@ int getWords(Database const db, std::vector<std::string> *const out,
 int getWordPositions(Database const db, std::string const &word,
                      std::vector<std::size_t> *const pos);
 
+/* DESCRIPTION:
+ *
+ * Returns a read-only view of the positions of 'word' without copying
+ * them. With a memory budget the view points into the mapped file
+ * holding the spilled positions. It stays valid as long as the database.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'word' argument is not present within the database.
+ *
+ * 3 - The 'pos' argument is a nullptr.
+ */
+int getWordPositionsView(Database const db, std::string const &word,
+                         std::span<std::size_t const> *const pos);
+
+/* DESCRIPTION:
+ *
+ * Returns how many times 'word' occurs in the database.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'word' argument is not present within the database.
+ *
+ * 3 - The 'count' argument is a nullptr.
+ */
+int getWordCount(Database const db, std::string const &word,
+                 std::size_t *const count);
+
 /* EXIT STATUS:
  *
  * 0 - The operation was successful.
@@ -95,4 +228,18 @@ int getWordPositions(Database const db, std::string const &word,
  * 2 - The 'count' argument is a nullptr.
  */
 int getTotalWordCount(Database const db, std::size_t *const count);
+
+/* DESCRIPTION:
+ *
+ * Returns how many distinct words occur in the database.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'count' argument is a nullptr.
+ */
+int getUniqueWordCount(Database const db, std::size_t *const count);
 } // namespace qy
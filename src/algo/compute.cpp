@@ -10,28 +10,38 @@ int computeSinglePairDistances(std::vector<std::size_t> const *const posA,
     return 1;
   if (!posB)
     return 2;
+  return computeSinglePairDistances(std::span{*posA}, std::span{*posB},
+                                    totalWordCount, out);
+}
+
+int computeSinglePairDistances(std::span<std::size_t const> const posA,
+                               std::span<std::size_t const> const posB,
+                               std::size_t const totalWordCount,
+                               std::vector<std::size_t> *const out) {
   if (!out)
     return 3;
 
   out->clear();
-  out->reserve(posA->size());
+  if (posA.empty() || posB.empty())
+    return 0;
+  out->reserve(posA.size());
 
-  for (std::size_t i = 0; i < posA->size(); ++i) {
+  for (std::size_t i = 0; i < posA.size(); ++i) {
     bool loopAround = false;
-    auto nearestB = std::upper_bound(posB->begin(), posB->end(), posA->at(i));
-    if (nearestB == posB->end()) {
-      nearestB = posB->begin();
+    auto nearestB = std::upper_bound(posB.begin(), posB.end(), posA[i]);
+    if (nearestB == posB.end()) {
+      nearestB = posB.begin();
       loopAround = true;
     }
 
-    auto nearestA = posA->begin();
+    auto nearestA = posA.begin();
     if (loopAround)
-      nearestA = --(posA->end());
+      nearestA = std::prev(posA.end());
     else
       nearestA =
-          std::prev(std::lower_bound(posA->begin(), posA->end(), *nearestB));
+          std::prev(std::lower_bound(posA.begin(), posA.end(), *nearestB));
 
-    i = nearestA - posA->begin();
+    i = nearestA - posA.begin();
 
     if (*nearestA == *nearestB)
       continue;
@@ -44,4 +54,86 @@ int computeSinglePairDistances(std::vector<std::size_t> const *const posA,
 
   return 0;
 }
+
+namespace {
+/* Returns the first index from 'lo' on whose element is not 'before',
+ * given that the elements 'before' form a prefix of 'v'. The search
+ * doubles its step from 'lo', so nearby matches are found quickly. */
+template <typename Before>
+std::size_t gallop(std::span<std::size_t const> const v, std::size_t lo,
+                   Before const &before) {
+  std::size_t hi = lo, step = 1;
+  while (hi < v.size() && before(v[hi])) {
+    lo = hi + 1;
+    hi = lo + step;
+    step <<= 1;
+  }
+  hi = std::min(hi, v.size());
+  return std::partition_point(v.begin() + lo, v.begin() + hi, before) -
+         v.begin();
+}
+} // namespace
+
+bool pairWithinReach(std::span<std::size_t const> const posA,
+                     std::span<std::size_t const> const posB,
+                     std::size_t const totalWordCount,
+                     DistanceWindowT const &window) {
+  if (posA.empty() || posB.empty())
+    return false;
+  if (!window.maxDistance && window.wrapAround)
+    return true;
+
+  std::size_t const maxDistance =
+      window.maxDistance ? window.maxDistance : std::size_t(-1);
+
+  // Only the last occurrence of A wraps around,
+  // and only when no occurrence of B follows it.
+  if (window.wrapAround && posA.back() >= posB.back() &&
+      posA.back() != posB.front() &&
+      totalWordCount - posA.back() + posB.front() <= maxDistance)
+    return true;
+
+  // Every other distance spans from an occurrence of A
+  // to a later occurrence of B.
+  if (posB.back() <= posA.front())
+    return false;
+  return posB.front() <= posA.back() ||
+         posB.front() - posA.back() <= maxDistance;
+}
+
+int computeWindowedPairDistances(std::span<std::size_t const> const a,
+                                 std::span<std::size_t const> const b,
+                                 std::size_t const totalWordCount,
+                                 DistanceWindowT const &window,
+                                 std::vector<std::size_t> *const out) {
+  if (!out)
+    return 1;
+
+  out->clear();
+  if (!pairWithinReach(a, b, totalWordCount, window))
+    return 0;
+
+  std::size_t const maxDistance =
+      window.maxDistance ? window.maxDistance : std::size_t(-1);
+
+  std::size_t i = 0, j = 0;
+  while (i < a.size()) {
+    j = gallop(b, j, [&](std::size_t const p) { return p <= a[i]; });
+    if (j == b.size())
+      break;
+
+    // The last occurrence of A before the occurrence of B.
+    std::size_t const k =
+        gallop(a, i, [&](std::size_t const p) { return p < b[j]; }) - 1;
+    if (b[j] - a[k] <= maxDistance)
+      out->push_back(b[j] - a[k]);
+    i = k + 1;
+  }
+
+  if (window.wrapAround && a.back() >= b.back() && a.back() != b.front() &&
+      totalWordCount - a.back() + b.front() <= maxDistance)
+    out->push_back(totalWordCount - a.back() + b.front());
+
+  return 0;
+}
 } // namespace al
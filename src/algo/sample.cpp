@@ -0,0 +1,120 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <verbmeter/algo.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace al {
+namespace {
+/* Returns the distance stored for the occurrence of A at 'index',
+ * or 0 if computeSinglePairDistances would not store any for it.
+ * Sets 'wrapped' if the distance wraps around the end of the text. */
+std::size_t distanceOf(std::span<std::size_t const> const posA,
+                       std::span<std::size_t const> const posB,
+                       std::size_t const totalWordCount,
+                       std::size_t const index, bool *const wrapped) {
+  std::size_t const a = posA[index];
+  auto const nearestB = std::upper_bound(posB.begin(), posB.end(), a);
+
+  *wrapped = nearestB == posB.end();
+  if (*wrapped) {
+    if (index != posA.size() - 1 || a == posB.front())
+      return 0;
+    return totalWordCount - a + posB.front();
+  }
+
+  auto const nearestA =
+      std::prev(std::lower_bound(posA.begin(), posA.end(), *nearestB));
+  if (std::size_t(nearestA - posA.begin()) != index)
+    return 0;
+  return *nearestB - a;
+}
+} // namespace
+
+int sampleSinglePairDistances(std::span<std::size_t const> const posA,
+                              std::span<std::size_t const> const posB,
+                              std::size_t const totalWordCount,
+                              std::size_t const sampleBudget,
+                              std::uint64_t const seed,
+                              std::vector<std::size_t> *const out,
+                              DistanceSampleT *const sample,
+                              DistanceWindowT const &window) {
+  if (!out)
+    return 1;
+  if (!sample)
+    return 2;
+  if (!sampleBudget)
+    return 3;
+
+  out->clear();
+  *sample = {};
+  if (posA.empty() || posB.empty() ||
+      !pairWithinReach(posA, posB, totalWordCount, window)) {
+    sample->distanceAvg = std::nan("");
+    return 0;
+  }
+
+  std::size_t const maxDistance =
+      window.maxDistance ? window.maxDistance : std::size_t(-1);
+  std::size_t const n = posA.size();
+  bool const exact = n <= sampleBudget;
+  std::size_t const strata = exact ? n : sampleBudget;
+  std::mt19937_64 rng{seed};
+
+  out->reserve(strata);
+  for (std::size_t s = 0; s < strata; ++s) {
+    std::size_t index = s;
+    if (!exact) {
+      std::size_t const begin = s * n / strata;
+      std::size_t const end = (s + 1) * n / strata;
+      index = begin + std::size_t(rng() % (end - begin));
+    }
+
+    bool wrapped{};
+    if (auto distance = distanceOf(posA, posB, totalWordCount, index, &wrapped);
+        distance && distance <= maxDistance && (window.wrapAround || !wrapped))
+      out->push_back(distance);
+  }
+
+  std::size_t const count = out->size();
+  sample->sampledCount = strata;
+  if (!count) {
+    sample->distanceAvg = std::nan("");
+    return 0;
+  }
+
+  double sum{}, squares{};
+  for (auto const distance : *out) {
+    sum += double(distance);
+    squares += double(distance) * double(distance);
+  }
+  sample->distanceAvg = sum / double(count);
+
+  if (!exact && count > 1) {
+    double const variance =
+        (squares - sum * sample->distanceAvg) / double(count - 1);
+    sample->confidence =
+        1.96 * std::sqrt(std::max(variance, 0.0) / double(count));
+  }
+  return 0;
+}
+} // namespace al
@@ -0,0 +1,118 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include <verbmeter/algo.hpp>
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <set>
+
+namespace {
+/* Returns a sorted list of distinct positions below 'totalWordCount'. */
+std::vector<std::size_t> randomPositions(std::mt19937_64 *const rng,
+                                         std::size_t const totalWordCount) {
+  std::set<std::size_t> positions{};
+  std::size_t const count = (*rng)() % 8;
+  for (std::size_t i = 0; i < count; ++i)
+    positions.insert((*rng)() % totalWordCount);
+  return {positions.begin(), positions.end()};
+}
+
+/* Filters the distances of computeSinglePairDistances by the window.
+ * The wrap-around distance, if any, is the last one stored. */
+std::vector<std::size_t> expectedDistances(std::vector<std::size_t> const &posA,
+                                           std::vector<std::size_t> const &posB,
+                                           std::size_t const totalWordCount,
+                                           al::DistanceWindowT const &window) {
+  std::vector<std::size_t> full{}, expected{};
+  al::computeSinglePairDistances(&posA, &posB, totalWordCount, &full);
+
+  bool const wraps = !posA.empty() && !posB.empty() &&
+                     posA.back() >= posB.back() && posA.back() != posB.front();
+  for (std::size_t i = 0; i < full.size(); ++i) {
+    if (wraps && i + 1 == full.size() && !window.wrapAround)
+      continue;
+    if (window.maxDistance && full[i] > window.maxDistance)
+      continue;
+    expected.push_back(full[i]);
+  }
+  return expected;
+}
+
+void printList(char const *const name, std::vector<std::size_t> const &list) {
+  std::cerr << "  " << name << ":";
+  for (auto const value : list)
+    std::cerr << " " << value;
+  std::cerr << "\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: <case count> [<seed>]\n";
+    return 1;
+  }
+
+  std::size_t caseCount{}, seed{};
+  for (int i = 1; i < argc; ++i) {
+    try {
+      (i == 1 ? caseCount : seed) = std::stoull(argv[i]);
+    } catch (...) {
+      std::cerr << "Failed to convert: '" << argv[i] << "' to a number\n";
+      return 1;
+    }
+  }
+
+  std::mt19937_64 rng{seed};
+  std::size_t failures{};
+  for (std::size_t c = 0; c < caseCount; ++c) {
+    std::size_t const totalWordCount = 1 + rng() % 64;
+    auto const posA = randomPositions(&rng, totalWordCount);
+    auto const posB = rng() % 4 ? randomPositions(&rng, totalWordCount) : posA;
+    al::DistanceWindowT const window{rng() % 24, bool(rng() % 2)};
+
+    auto const expected =
+        expectedDistances(posA, posB, totalWordCount, window);
+    std::vector<std::size_t> windowed{};
+    al::computeWindowedPairDistances(posA, posB, totalWordCount, window,
+                                     &windowed);
+
+    // A pruned pair must not have had any distance within the window.
+    bool const reach =
+        al::pairWithinReach(posA, posB, totalWordCount, window);
+
+    if (windowed == expected && (reach || expected.empty()))
+      continue;
+
+    if (failures++ < 10) {
+      std::cerr << "Mismatch in case " << c << ", total word count "
+                << totalWordCount << ", max distance " << window.maxDistance
+                << ", wrap around " << window.wrapAround << ", within reach "
+                << reach << "\n";
+      printList("A", posA);
+      printList("B", posB);
+      printList("expected", expected);
+      printList("windowed", windowed);
+    }
+  }
+
+  std::cout << caseCount - failures << "/" << caseCount << " cases passed\n";
+  return failures ? 2 : 0;
+}
@@ -0,0 +1,185 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "cache.hpp"
+#include <filesystem>
+
+namespace vr {
+namespace {
+/* RECORD LAYOUT:
+ *
+ * Each record holds the length and bytes of both words, followed by
+ * the number of distances and the distances, all numbers as uint64.
+ * A truncated trailing record, e.g. from an interrupted run, is ignored.
+ */
+std::string pairKey(std::string const &wordA, std::string const &wordB) {
+  std::string key{wordA};
+  key.push_back('\0');
+  key += wordB;
+  return key;
+}
+
+bool readNumber(std::istream &in, std::uint64_t *const value) {
+  return bool(in.read(reinterpret_cast<char *>(value), sizeof(*value)));
+}
+
+void writeNumber(std::ostream &out, std::uint64_t const value) {
+  out.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+bool readWord(std::istream &in, std::string *const word) {
+  std::uint64_t length{};
+  if (!readNumber(in, &length))
+    return false;
+  word->resize(length);
+  return bool(in.read(word->data(), std::streamsize(length)));
+}
+
+void writeWord(std::ostream &out, std::string const &word) {
+  writeNumber(out, word.size());
+  out.write(word.data(), std::streamsize(word.size()));
+}
+
+constexpr std::uint64_t fnvOffsetBasis = 0xcbf29ce484222325ull;
+
+// FNV-1a
+std::uint64_t hashBytes(std::uint64_t hash, char const *const data,
+                        std::size_t const size) {
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= std::uint8_t(data[i]);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+} // namespace
+
+std::uint64_t hashBytes(std::string_view const data) {
+  return hashBytes(fnvOffsetBasis, data.data(), data.size());
+}
+
+int hashFile(std::string const &file, std::uint64_t *const hash) {
+  if (!hash)
+    return 1;
+
+  std::ifstream in{file, std::ios::binary};
+  if (!in.is_open())
+    return 2;
+
+  std::uint64_t value = fnvOffsetBasis;
+  std::vector<char> buffer(1 << 20);
+  while (in.read(buffer.data(), std::streamsize(buffer.size())) ||
+         in.gcount())
+    value = hashBytes(value, buffer.data(), std::size_t(in.gcount()));
+
+  *hash = value;
+  return 0;
+}
+
+int openPairCache(std::string const &cacheDir, std::string const &inputFile,
+                  std::string const &variant, PairCacheT *const cache) {
+  if (!cache)
+    return 1;
+  if (!std::filesystem::is_directory(cacheDir))
+    return 2;
+
+  std::uint64_t hash{};
+  if (hashFile(inputFile, &hash))
+    return 3;
+
+  std::string name = std::to_string(hash) + "-" +
+                     std::to_string(std::filesystem::file_size(inputFile));
+  if (!variant.empty())
+    name += "-" + variant;
+
+  *cache = {};
+  cache->file = (std::filesystem::path(cacheDir) / (name + ".cache")).string();
+
+  std::error_code error{};
+  auto const fileSize = std::filesystem::file_size(cache->file, error);
+  if (error)
+    return 0;
+
+  cache->in.open(cache->file, std::ios::binary);
+  std::string wordA{}, wordB{};
+  std::uint64_t count{};
+  while (readWord(cache->in, &wordA) && readWord(cache->in, &wordB) &&
+         readNumber(cache->in, &count)) {
+    auto const offset = std::uint64_t(cache->in.tellg());
+    if (count > (fileSize - offset) / sizeof(std::uint64_t))
+      break;
+    cache->pairs.insert_or_assign(pairKey(wordA, wordB),
+                                  CachedPairT{offset, count});
+    cache->in.seekg(std::streamoff(offset + count * sizeof(std::uint64_t)));
+  }
+  cache->in.clear();
+  return 0;
+}
+
+bool findCachedPair(PairCacheT *const cache, std::string const &wordA,
+                    std::string const &wordB,
+                    std::vector<std::size_t> *const out) {
+  if (!cache || !out)
+    return false;
+
+  auto const entry = cache->pairs.find(pairKey(wordA, wordB));
+  if (entry == cache->pairs.end()) {
+    ++cache->misses;
+    return false;
+  }
+
+  auto const [offset, count] = entry->second;
+  std::vector<std::uint64_t> distances(count);
+  cache->in.seekg(std::streamoff(offset));
+  if (!cache->in.read(reinterpret_cast<char *>(distances.data()),
+                      std::streamsize(count * sizeof(std::uint64_t)))) {
+    cache->in.clear();
+    ++cache->misses;
+    return false;
+  }
+
+  out->assign(distances.begin(), distances.end());
+  ++cache->hits;
+  return true;
+}
+
+void storeCachedPair(PairCacheT *const cache, std::string const &wordA,
+                     std::string const &wordB,
+                     std::vector<std::size_t> const &distances) {
+  if (!cache)
+    return;
+
+  if (!cache->out.is_open())
+    cache->out.open(cache->file, std::ios::binary | std::ios::app);
+  writeWord(cache->out, wordA);
+  writeWord(cache->out, wordB);
+  writeNumber(cache->out, distances.size());
+  for (auto const distance : distances)
+    writeNumber(cache->out, distance);
+}
+
+int savePairCache(PairCacheT *const cache) {
+  if (!cache)
+    return 1;
+  // A failed open or write leaves the stream failed as well.
+  if (cache->out.is_open())
+    cache->out.close();
+  return cache->out ? 0 : 2;
+}
+} // namespace vr
@@ -0,0 +1,122 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace vr {
+/* The distances of a cached pair within the cache file. */
+struct CachedPairT {
+  std::uint64_t offset{};
+  std::uint64_t count{};
+};
+
+/* DESCRIPTION:
+ *
+ * Indexes the distances of the word pairs computed by previous runs
+ * on the same corpus. The corpus is identified by the hash of its
+ * contents, each corpus has its own append-only file in the cache dir.
+ * Only the offsets of the pairs are held in memory, their distances are
+ * read from the file once they are looked up.
+ */
+struct PairCacheT {
+  std::string file{};
+  std::ifstream in{};
+  std::ofstream out{};
+  std::unordered_map<std::string, CachedPairT> pairs{};
+  std::size_t hits{};
+  std::size_t misses{};
+};
+
+/* DESCRIPTION:
+ *
+ * Returns the FNV-1a hash of 'data'. Unlike std::hash, it does not
+ * depend on the toolchain, so it can name files kept across builds.
+ */
+std::uint64_t hashBytes(std::string_view const data);
+
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'hash' argument is a nullptr.
+ *
+ * 2 - The 'file' argument could not be read.
+ */
+int hashFile(std::string const &file, std::uint64_t *const hash);
+
+/* DESCRIPTION:
+ *
+ * Indexes the pairs cached for the corpus 'inputFile' within 'cacheDir'.
+ * 'variant' distinguishes the results of different distance settings
+ * on the same corpus.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'cache' argument is a nullptr.
+ *
+ * 2 - The 'cacheDir' argument is not a directory.
+ *
+ * 3 - The 'inputFile' argument could not be read.
+ */
+int openPairCache(std::string const &cacheDir, std::string const &inputFile,
+                  std::string const &variant, PairCacheT *const cache);
+
+/* DESCRIPTION:
+ *
+ * Reads the cached distances of the pair into 'out'. Returns false
+ * if the pair is not cached or could not be read. Counts the lookup
+ * towards the hit rate.
+ */
+bool findCachedPair(PairCacheT *const cache, std::string const &wordA,
+                    std::string const &wordB, std::vector<std::size_t> *out);
+
+/* DESCRIPTION:
+ *
+ * Appends the distances of the pair to the cache file as they are,
+ * without keeping a copy in memory.
+ */
+void storeCachedPair(PairCacheT *const cache, std::string const &wordA,
+                     std::string const &wordB,
+                     std::vector<std::size_t> const &distances);
+
+/* DESCRIPTION:
+ *
+ * Flushes the pairs stored since the cache was opened to its file.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'cache' argument is a nullptr.
+ *
+ * 2 - Writing the cache file failed.
+ */
+int savePairCache(PairCacheT *const cache);
+} // namespace vr
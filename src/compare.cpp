@@ -0,0 +1,214 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "compare.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace vr {
+namespace {
+constexpr std::size_t laneCount = 8;
+constexpr std::size_t blockSize = 32;
+
+/* The kernels accumulate into 'laneCount' independent lanes,
+ * which lets the compiler keep them in a single vector register. */
+float sumOfAbsDiff(float const *const a, float const *const b,
+                   std::size_t const stride) {
+  float lanes[laneCount]{};
+  for (std::size_t f = 0; f < stride; f += laneCount)
+    for (std::size_t l = 0; l < laneCount; ++l)
+      lanes[l] += std::fabs(a[f + l] - b[f + l]);
+
+  float sum{};
+  for (std::size_t l = 0; l < laneCount; ++l)
+    sum += lanes[l];
+  return sum;
+}
+
+float sumOfSquaredDiff(float const *const a, float const *const b,
+                       std::size_t const stride) {
+  float lanes[laneCount]{};
+  for (std::size_t f = 0; f < stride; f += laneCount)
+    for (std::size_t l = 0; l < laneCount; ++l) {
+      float const diff = a[f + l] - b[f + l];
+      lanes[l] += diff * diff;
+    }
+
+  float sum{};
+  for (std::size_t l = 0; l < laneCount; ++l)
+    sum += lanes[l];
+  return sum;
+}
+
+float dotProduct(float const *const a, float const *const b,
+                 std::size_t const stride) {
+  float lanes[laneCount]{};
+  for (std::size_t f = 0; f < stride; f += laneCount)
+    for (std::size_t l = 0; l < laneCount; ++l)
+      lanes[l] += a[f + l] * b[f + l];
+
+  float sum{};
+  for (std::size_t l = 0; l < laneCount; ++l)
+    sum += lanes[l];
+  return sum;
+}
+
+/* Replaces each feature with its z-score across the documents.
+ * Features that do not vary become 0 in every document. */
+void standardize(SignatureMatrixT *const matrix) {
+  std::size_t const n = matrix->documentCount;
+  for (std::size_t f = 0; f < matrix->featureCount; ++f) {
+    double mean{}, variance{};
+    for (std::size_t d = 0; d < n; ++d)
+      mean += matrix->values[d * matrix->stride + f];
+    mean /= double(n);
+    for (std::size_t d = 0; d < n; ++d) {
+      double const diff = matrix->values[d * matrix->stride + f] - mean;
+      variance += diff * diff;
+    }
+    double const deviation = std::sqrt(variance / double(n));
+
+    for (std::size_t d = 0; d < n; ++d) {
+      float &value = matrix->values[d * matrix->stride + f];
+      value = deviation > 0.0 ? float((value - mean) / deviation) : 0.0f;
+    }
+  }
+}
+
+double pairDistance(SignatureMatrixT const *const matrix, MetricE const metric,
+                    std::vector<float> const &norms, std::size_t const a,
+                    std::size_t const b) {
+  float const *const rowA = matrix->values.data() + a * matrix->stride;
+  float const *const rowB = matrix->values.data() + b * matrix->stride;
+
+  switch (metric) {
+  case MetricE::Cosine: {
+    float const norm = norms[a] * norms[b];
+    if (norm == 0.0f)
+      return 1.0;
+    return 1.0 - double(dotProduct(rowA, rowB, matrix->stride)) / norm;
+  }
+  case MetricE::Delta:
+    return double(sumOfAbsDiff(rowA, rowB, matrix->stride)) /
+           double(std::max<std::size_t>(matrix->featureCount, 1));
+  case MetricE::Euclidean:
+    return std::sqrt(double(sumOfSquaredDiff(rowA, rowB, matrix->stride)));
+  }
+  return 0.0;
+}
+} // namespace
+
+int createSignatureMatrix(std::size_t const documentCount,
+                          std::size_t const featureCount,
+                          SignatureMatrixT *const matrix) {
+  if (!matrix)
+    return 1;
+
+  matrix->documentCount = documentCount;
+  matrix->featureCount = featureCount;
+  matrix->stride = (featureCount + laneCount - 1) / laneCount * laneCount;
+  matrix->values.assign(documentCount * matrix->stride, 0.0f);
+  return 0;
+}
+
+int fillSignature(DistanceHistogramT const *const hist,
+                  std::size_t const totalWordCount, std::size_t const document,
+                  SignatureMatrixT *const matrix) {
+  if (!hist)
+    return 1;
+  if (!matrix)
+    return 2;
+  if (hist->distanceAvg.size() != matrix->featureCount ||
+      document >= matrix->documentCount)
+    return 3;
+
+  float *const row = matrix->values.data() + document * matrix->stride;
+  for (std::size_t f = 0; f < matrix->featureCount; ++f) {
+    double const avg = hist->distanceAvg[f];
+    row[f] = std::isnan(avg) || !totalWordCount
+                 ? 1.0f
+                 : float(avg / double(totalWordCount));
+  }
+  return 0;
+}
+
+int computeDistanceMatrix(SignatureMatrixT const *const matrix,
+                          MetricE const metric, std::size_t threadCount,
+                          std::vector<double> *const out) {
+  if (!matrix)
+    return 1;
+  if (!out)
+    return 2;
+
+  std::size_t const n = matrix->documentCount;
+  out->assign(n * n, 0.0);
+
+  SignatureMatrixT standardized{};
+  if (metric == MetricE::Delta) {
+    standardized = *matrix;
+    standardize(&standardized);
+  }
+  auto const *const source = metric == MetricE::Delta ? &standardized : matrix;
+
+  std::vector<float> norms(n);
+  for (std::size_t d = 0; d < n; ++d) {
+    float const *const row = source->values.data() + d * source->stride;
+    norms[d] = std::sqrt(dotProduct(row, row, source->stride));
+  }
+
+  // The upper triangle is split into blocks, so that the rows of a block
+  // stay in cache while they are compared with each other.
+  std::size_t const blockCount = (n + blockSize - 1) / blockSize;
+  std::vector<std::pair<std::size_t, std::size_t>> blocks{};
+  for (std::size_t bi = 0; bi < blockCount; ++bi)
+    for (std::size_t bj = bi; bj < blockCount; ++bj)
+      blocks.push_back({bi, bj});
+
+  std::atomic<std::size_t> nextBlock{};
+  auto worker = [&]() {
+    for (std::size_t b = nextBlock++; b < blocks.size(); b = nextBlock++) {
+      auto const [bi, bj] = blocks[b];
+      for (std::size_t i = bi * blockSize; i < std::min(n, (bi + 1) * blockSize);
+           ++i)
+        for (std::size_t j = std::max(i + 1, bj * blockSize);
+             j < std::min(n, (bj + 1) * blockSize); ++j) {
+          double const distance = pairDistance(source, metric, norms, i, j);
+          (*out)[i * n + j] = distance;
+          (*out)[j * n + i] = distance;
+        }
+    }
+  };
+
+  if (!threadCount)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  threadCount = std::min(threadCount, std::max<std::size_t>(blocks.size(), 1));
+
+  std::vector<std::thread> threads{};
+  for (std::size_t t = 1; t < threadCount; ++t)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+
+  return 0;
+}
+} // namespace vr
@@ -0,0 +1,94 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "histogram.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vr {
+/* DESCRIPTION:
+ *
+ * Holds one signature per document, row after row.
+ * Each row is 'stride' values long, the values past 'featureCount'
+ * are zero padding that keeps every row aligned to the kernel width.
+ */
+struct SignatureMatrixT {
+  std::size_t documentCount{};
+  std::size_t featureCount{};
+  std::size_t stride{};
+  std::vector<float> values{};
+};
+
+enum class MetricE { Cosine, Delta, Euclidean };
+
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'matrix' argument is a nullptr.
+ */
+int createSignatureMatrix(std::size_t const documentCount,
+                          std::size_t const featureCount,
+                          SignatureMatrixT *const matrix);
+
+/* DESCRIPTION:
+ *
+ * Fills the signature of the document in row 'document' with the average
+ * distance of each word pair, relative to the length of the document.
+ * A pair that never occurs gets the distance 1, the length of the document.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'hist' argument is a nullptr.
+ *
+ * 2 - The 'matrix' argument is a nullptr.
+ *
+ * 3 - The histogram does not match the signature length,
+ *     or 'document' is out of range.
+ */
+int fillSignature(DistanceHistogramT const *const hist,
+                  std::size_t const totalWordCount, std::size_t const document,
+                  SignatureMatrixT *const matrix);
+
+/* DESCRIPTION:
+ *
+ * Computes the distance between every two documents into the
+ * row-major 'documentCount' x 'documentCount' matrix 'out'.
+ * The Delta metric is Burrows' Delta, the mean absolute difference
+ * of the features standardized across all the documents.
+ * If 'threadCount' is equal to 0, the hardware concurrency is used.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'matrix' argument is a nullptr.
+ *
+ * 2 - The 'out' argument is a nullptr.
+ */
+int computeDistanceMatrix(SignatureMatrixT const *const matrix,
+                          MetricE const metric, std::size_t threadCount,
+                          std::vector<double> *const out);
+} // namespace vr
@@ -0,0 +1,137 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "ipc.hpp"
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace ipc {
+namespace {
+int makeAddress(std::string const &path, sockaddr_un *const address) {
+  if (path.size() >= sizeof(address->sun_path))
+    return 1;
+  std::memset(address, 0, sizeof(*address));
+  address->sun_family = AF_UNIX;
+  std::memcpy(address->sun_path, path.c_str(), path.size() + 1);
+  return 0;
+}
+} // namespace
+
+int listenSocket(std::string const &path, int *const fd) {
+  if (!fd)
+    return 1;
+
+  sockaddr_un address{};
+  if (makeAddress(path, &address))
+    return 2;
+
+  *fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (*fd < 0)
+    return 3;
+
+  ::unlink(path.c_str());
+  if (::bind(*fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) ||
+      ::listen(*fd, SOMAXCONN)) {
+    ::close(*fd);
+    *fd = -1;
+    return 3;
+  }
+  return 0;
+}
+
+int acceptConnection(int const fd, ConnectionT *const conn) {
+  if (!conn)
+    return 1;
+
+  conn->buffer.clear();
+  conn->fd = ::accept(fd, nullptr, nullptr);
+  if (conn->fd < 0)
+    return 2;
+  return 0;
+}
+
+int connectSocket(std::string const &path, ConnectionT *const conn) {
+  if (!conn)
+    return 1;
+
+  sockaddr_un address{};
+  if (makeAddress(path, &address))
+    return 2;
+
+  conn->buffer.clear();
+  conn->fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (conn->fd < 0)
+    return 3;
+
+  if (::connect(conn->fd, reinterpret_cast<sockaddr *>(&address),
+                sizeof(address))) {
+    closeConnection(conn);
+    return 3;
+  }
+  return 0;
+}
+
+int readLine(ConnectionT *const conn, std::string *const line) {
+  if (!conn || !line)
+    return 1;
+
+  std::size_t searchFrom = 0;
+  while (true) {
+    if (auto end = conn->buffer.find('\n', searchFrom);
+        end != std::string::npos) {
+      line->assign(conn->buffer, 0, end);
+      conn->buffer.erase(0, end + 1);
+      return 0;
+    }
+
+    searchFrom = conn->buffer.size();
+    char chunk[4096];
+    auto const received = ::read(conn->fd, chunk, sizeof(chunk));
+    if (received <= 0)
+      return 2;
+    conn->buffer.append(chunk, std::size_t(received));
+  }
+}
+
+int writeAll(ConnectionT *const conn, std::string const &data) {
+  if (!conn)
+    return 1;
+
+  std::size_t written = 0;
+  while (written < data.size()) {
+    auto const result =
+        ::send(conn->fd, data.data() + written, data.size() - written,
+               MSG_NOSIGNAL);
+    if (result <= 0)
+      return 2;
+    written += std::size_t(result);
+  }
+  return 0;
+}
+
+void closeConnection(ConnectionT *const conn) {
+  if (!conn || conn->fd < 0)
+    return;
+  ::close(conn->fd);
+  conn->fd = -1;
+}
+} // namespace ipc
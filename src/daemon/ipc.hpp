@@ -0,0 +1,102 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <string>
+
+namespace ipc {
+/* DESCRIPTION:
+ *
+ * The requests and responses exchanged over the socket are lines of text.
+ * A response starts with either 'OK <line count>' followed by that many
+ * lines, or with a single 'ERR <code> <message>' line.
+ */
+inline constexpr char const *defaultSocketPath = "/tmp/verbmeter.sock";
+
+struct ConnectionT {
+  int fd{-1};
+  std::string buffer{};
+};
+
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'fd' argument is a nullptr.
+ *
+ * 2 - The 'path' argument is too long for a socket address.
+ *
+ * 3 - Creating, binding or listening on the socket failed.
+ */
+int listenSocket(std::string const &path, int *const fd);
+
+/* DESCRIPTION:
+ *
+ * Blocks until a client connects to the listening socket 'fd'.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'conn' argument is a nullptr.
+ *
+ * 2 - Accepting the connection failed.
+ */
+int acceptConnection(int const fd, ConnectionT *const conn);
+
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'conn' argument is a nullptr.
+ *
+ * 2 - The 'path' argument is too long for a socket address.
+ *
+ * 3 - Creating or connecting the socket failed.
+ */
+int connectSocket(std::string const &path, ConnectionT *const conn);
+
+/* DESCRIPTION:
+ *
+ * Reads a single line, without the trailing newline.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'conn' or 'line' argument is a nullptr.
+ *
+ * 2 - The peer closed the connection or reading failed.
+ */
+int readLine(ConnectionT *const conn, std::string *const line);
+
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'conn' argument is a nullptr.
+ *
+ * 2 - Writing failed.
+ */
+int writeAll(ConnectionT *const conn, std::string const &data);
+
+void closeConnection(ConnectionT *const conn);
+} // namespace ipc
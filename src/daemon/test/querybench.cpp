@@ -0,0 +1,191 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "../ipc.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+/* Sends the request and reads the whole response.
+ * Returns the response lines, the status line excluded. */
+int request(ipc::ConnectionT *const conn, std::string const &req,
+            std::vector<std::string> *const lines) {
+  std::string line{};
+  if (ipc::writeAll(conn, req + "\n") || ipc::readLine(conn, &line))
+    return 1;
+  if (line.rfind("OK ", 0))
+    return 2;
+
+  lines->clear();
+  std::size_t const lineCount = std::stoull(line.substr(3));
+  for (std::size_t i = 0; i < lineCount; ++i) {
+    if (ipc::readLine(conn, &line))
+      return 1;
+    lines->push_back(std::move(line));
+  }
+  return 0;
+}
+
+using ClockT = std::chrono::steady_clock;
+
+std::vector<std::string> const kinds{"STATS", "WORDS", "POSITIONS",
+                                     "DISTANCES"};
+
+/* Issues 'queryCount' requests over its own connection, cycling through
+ * the query kinds. Records the latency of each request by its kind. */
+int runClient(std::string const &socketPath, std::string const &corpus,
+              std::vector<std::string> const &words, std::size_t const offset,
+              std::size_t const queryCount,
+              std::vector<std::vector<double>> *const latency) {
+  ipc::ConnectionT conn{};
+  if (ipc::connectSocket(socketPath, &conn))
+    return 1;
+
+  std::string const wordCount = std::to_string(words.size());
+  std::vector<std::string> lines{};
+  latency->assign(kinds.size(), {});
+
+  for (std::size_t n = 0; n < queryCount; ++n) {
+    std::size_t const i = n + offset;
+    std::size_t const kind = i % kinds.size();
+    std::string const &wordA = words[i % words.size()];
+    std::string const &wordB = words[(i / words.size()) % words.size()];
+
+    std::string req = kinds[kind] + " " + corpus;
+    if (kinds[kind] == "WORDS")
+      req += " " + wordCount;
+    else if (kinds[kind] == "POSITIONS")
+      req += " " + wordA;
+    else if (kinds[kind] == "DISTANCES")
+      req += " " + wordA + " " + wordB;
+
+    auto const start = ClockT::now();
+    if (request(&conn, req, &lines)) {
+      ipc::closeConnection(&conn);
+      return 2;
+    }
+    std::chrono::duration<double, std::micro> const elapsed =
+        ClockT::now() - start;
+    (*latency)[kind].push_back(elapsed.count());
+  }
+
+  ipc::closeConnection(&conn);
+  return 0;
+}
+
+void printLatency(std::string const &name, std::vector<double> *const us) {
+  if (us->empty())
+    return;
+  std::sort(us->begin(), us->end());
+  auto percentile = [us](double const p) {
+    return (*us)[std::size_t(p * double(us->size() - 1))];
+  };
+  std::cout << name << ": n=" << us->size() << " p50=" << percentile(0.5)
+            << "us p99=" << percentile(0.99) << "us\n";
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc != 5) {
+    std::cerr << "Usage: <socket path> <corpus file> <client count> "
+                 "<query count per client>\n";
+    return 1;
+  }
+
+  std::string const corpus = "querybench";
+  std::size_t clientCount{}, queryCount{};
+  for (int i = 3; i < 5; ++i) {
+    try {
+      (i == 3 ? clientCount : queryCount) = std::stoull(argv[i]);
+    } catch (...) {
+      std::cerr << "Failed to convert: '" << argv[i] << "' to a number\n";
+      return 1;
+    }
+  }
+  if (!clientCount) {
+    std::cerr << "The client count must be greater than 0\n";
+    return 1;
+  }
+
+  ipc::ConnectionT conn{};
+  if (auto error = ipc::connectSocket(argv[1], &conn); error) {
+    std::cerr << "Failed to connect with error code: " << error << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> lines{};
+
+  auto const loadStart = ClockT::now();
+  if (request(&conn, "LOAD " + corpus + " " + argv[2], &lines)) {
+    std::cerr << "Failed to load the corpus\n";
+    return 2;
+  }
+  std::chrono::duration<double, std::milli> const loadTime =
+      ClockT::now() - loadStart;
+  std::cout << "LOAD: " << loadTime.count() << "ms\n";
+
+  std::vector<std::string> words{};
+  if (request(&conn, "WORDS " + corpus + " 0", &words) || words.size() < 2) {
+    std::cerr << "The corpus has too few words\n";
+    return 2;
+  }
+  words.resize(std::min<std::size_t>(words.size(), 50));
+
+  std::vector<std::vector<std::vector<double>>> clientLatency(clientCount);
+  std::vector<int> clientError(clientCount);
+  std::vector<std::thread> clients{};
+  clients.reserve(clientCount);
+
+  auto const runStart = ClockT::now();
+  for (std::size_t c = 0; c < clientCount; ++c)
+    clients.emplace_back([&, c] {
+      clientError[c] = runClient(argv[1], corpus, words, c * queryCount,
+                                 queryCount, &clientLatency[c]);
+    });
+  for (auto &client : clients)
+    client.join();
+  std::chrono::duration<double> const runTime = ClockT::now() - runStart;
+
+  int status = 0;
+  for (std::size_t c = 0; c < clientCount; ++c)
+    if (clientError[c]) {
+      std::cerr << "Client " << c << " failed with error code: "
+                << clientError[c] << std::endl;
+      status = 2;
+    }
+
+  std::vector<std::vector<double>> latency(kinds.size());
+  for (auto const &client : clientLatency)
+    for (std::size_t k = 0; k < client.size(); ++k)
+      latency[k].insert(latency[k].end(), client[k].begin(), client[k].end());
+
+  std::cout << "clients=" << clientCount << " throughput="
+            << double(clientCount * queryCount) / runTime.count()
+            << " queries/s\n";
+  for (std::size_t i = 0; i < kinds.size(); ++i)
+    printLatency(kinds[i], &latency[i]);
+
+  request(&conn, "UNLOAD " + corpus, &lines);
+  ipc::closeConnection(&conn);
+  return status;
+}
@@ -0,0 +1,71 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "ipc.hpp"
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char **argv) {
+  std::string path = ipc::defaultSocketPath;
+  int first = 1;
+  if (argc > 2 && !std::strcmp(argv[1], "-s")) {
+    path = argv[2];
+    first = 3;
+  }
+
+  if (first >= argc) {
+    std::cerr << "Usage: [-s <socket path>] <command> <corpus> [<argument>]...";
+    return 1;
+  }
+
+  std::string request{};
+  for (int i = first; i < argc; ++i)
+    request += std::string(i > first ? " " : "") + argv[i];
+
+  ipc::ConnectionT conn{};
+  if (auto error = ipc::connectSocket(path, &conn); error) {
+    std::cerr << "Failed to connect to: '" << path
+              << "' with error code: " << error << std::endl;
+    return 1;
+  }
+
+  std::string line{};
+  if (ipc::writeAll(&conn, request + "\n") || ipc::readLine(&conn, &line)) {
+    std::cerr << "The connection to the server was lost\n";
+    return 1;
+  }
+
+  if (line.rfind("OK ", 0)) {
+    std::cerr << line << std::endl;
+    return 2;
+  }
+
+  std::size_t const lineCount = std::stoull(line.substr(3));
+  for (std::size_t i = 0; i < lineCount; ++i) {
+    if (ipc::readLine(&conn, &line)) {
+      std::cerr << "The connection to the server was lost\n";
+      return 1;
+    }
+    std::cout << line << "\n";
+  }
+
+  ipc::closeConnection(&conn);
+  return 0;
+}
@@ -0,0 +1,227 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "ipc.hpp"
+#include <verbmeter/algo.hpp>
+#include <verbmeter/query.hpp>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+using SharedDatabase = std::shared_ptr<qy::DatabaseT>;
+
+/* The databases are never modified once they are registered,
+ * so the queries run concurrently without holding the registry lock. */
+struct RegistryT {
+  std::shared_mutex mutex{};
+  std::unordered_map<std::string, SharedDatabase> corpora{};
+};
+
+char socketPath[108]{};
+
+void onSignal(int) {
+  ::unlink(socketPath);
+  std::_Exit(0);
+}
+
+SharedDatabase findCorpus(RegistryT *const registry, std::string const &name) {
+  std::shared_lock lock{registry->mutex};
+  auto const entry = registry->corpora.find(name);
+  if (entry == registry->corpora.end())
+    return nullptr;
+  return entry->second;
+}
+
+std::string error(int const code, std::string const &message) {
+  return "ERR " + std::to_string(code) + " " + message + "\n";
+}
+
+std::string ok(std::vector<std::string> const &lines) {
+  std::string response = "OK " + std::to_string(lines.size()) + "\n";
+  for (auto const &line : lines)
+    response += line + "\n";
+  return response;
+}
+
+template <typename T> std::string join(std::vector<T> const &values) {
+  std::string line{};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    if (i)
+      line += ' ';
+    line += std::to_string(values[i]);
+  }
+  return line;
+}
+
+std::string load(RegistryT *const registry, std::string const &name,
+                 std::string const &file) {
+  auto dbPtr = qy::createUniqueDatabase();
+  if (!dbPtr)
+    return error(1, "failed to create the database");
+  if (auto err = qy::queryFile(dbPtr.get(), file); err)
+    return error(err, "failed to query the file: " + file);
+
+  SharedDatabase db{dbPtr.release(), qy::destroyDatabase};
+  std::unique_lock lock{registry->mutex};
+  registry->corpora.insert_or_assign(name, std::move(db));
+  return ok({});
+}
+
+std::string unload(RegistryT *const registry, std::string const &name) {
+  std::unique_lock lock{registry->mutex};
+  if (!registry->corpora.erase(name))
+    return error(2, "no such corpus: " + name);
+  return ok({});
+}
+
+std::string words(qy::Database const db, std::size_t const count) {
+  std::vector<std::string> out{};
+  if (auto err = qy::getWords(db, &out, count); err)
+    return error(err, "failed to get the words");
+  return ok(out);
+}
+
+std::string positions(qy::Database const db, std::string const &word) {
+  std::vector<std::size_t> out{};
+  if (auto err = qy::getWordPositions(db, word, &out); err)
+    return error(err, "failed to get the positions of: " + word);
+  return ok({join(out)});
+}
+
+std::string distances(qy::Database const db, std::string const &wordA,
+                      std::string const &wordB) {
+  std::vector<std::size_t> posA{}, posB{}, out{};
+  std::size_t totalWordCount{};
+  if (auto err = qy::getWordPositions(db, wordA, &posA); err)
+    return error(err, "failed to get the positions of: " + wordA);
+  if (auto err = qy::getWordPositions(db, wordB, &posB); err)
+    return error(err, "failed to get the positions of: " + wordB);
+  qy::getTotalWordCount(db, &totalWordCount);
+  if (auto err = al::computeSinglePairDistances(&posA, &posB, totalWordCount,
+                                                &out);
+      err)
+    return error(err, "failed to compute the distances");
+
+  auto const sum = std::accumulate(out.begin(), out.end(), std::size_t{});
+  return ok({"avg " + std::to_string(double(sum) / double(out.size())),
+             join(out)});
+}
+
+std::string stats(qy::Database const db) {
+  std::size_t totalWordCount{}, uniqueWordCount{};
+  qy::getTotalWordCount(db, &totalWordCount);
+  qy::getUniqueWordCount(db, &uniqueWordCount);
+  return ok({"words " + std::to_string(totalWordCount),
+             "unique " + std::to_string(uniqueWordCount)});
+}
+
+/* REQUESTS:
+ *
+ * LOAD <corpus> <file>
+ * UNLOAD <corpus>
+ * WORDS <corpus> <count>
+ * POSITIONS <corpus> <word>
+ * DISTANCES <corpus> <word> <word>
+ * STATS <corpus>
+ */
+std::string handleRequest(RegistryT *const registry,
+                          std::string const &request) {
+  std::istringstream stream{request};
+  std::string command{}, name{};
+  stream >> command >> name;
+  if (name.empty())
+    return error(1, "usage: <command> <corpus> [<argument>]...");
+
+  if (command == "LOAD") {
+    std::string file{};
+    std::getline(stream >> std::ws, file);
+    return load(registry, name, file);
+  }
+  if (command == "UNLOAD")
+    return unload(registry, name);
+
+  auto const db = findCorpus(registry, name);
+  if (!db)
+    return error(2, "no such corpus: " + name);
+
+  std::string argA{}, argB{};
+  stream >> argA >> argB;
+
+  if (command == "WORDS") {
+    try {
+      return words(db.get(), std::stoull(argA));
+    } catch (...) {
+      return error(1, "not a number: '" + argA + "'");
+    }
+  }
+  if (command == "POSITIONS")
+    return positions(db.get(), argA);
+  if (command == "DISTANCES")
+    return distances(db.get(), argA, argB);
+  if (command == "STATS")
+    return stats(db.get());
+  return error(1, "unknown command: " + command);
+}
+
+void serveConnection(RegistryT *const registry, ipc::ConnectionT conn) {
+  std::string request{};
+  while (!ipc::readLine(&conn, &request))
+    if (ipc::writeAll(&conn, handleRequest(registry, request)))
+      break;
+  ipc::closeConnection(&conn);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string const path = argc > 1 ? argv[1] : ipc::defaultSocketPath;
+  if (path.size() >= sizeof(socketPath)) {
+    std::cerr << "The socket path: '" << path << "' is too long\n";
+    return 1;
+  }
+  std::strcpy(socketPath, path.c_str());
+
+  int listenFd{-1};
+  if (auto error = ipc::listenSocket(path, &listenFd); error) {
+    std::cerr << "Failed to listen on: '" << path
+              << "' with error code: " << error << std::endl;
+    return 1;
+  }
+
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+
+  RegistryT registry{};
+  while (true) {
+    ipc::ConnectionT conn{};
+    if (ipc::acceptConnection(listenFd, &conn))
+      continue;
+    std::thread{serveConnection, &registry, std::move(conn)}.detach();
+  }
+}
@@ -20,69 +20,181 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include <verbmeter/algo.hpp>
 #include "histogram.hpp"
-#include <unordered_map>
+#include "cache.hpp"
+#include "writer.hpp"
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
-#include <fstream>
 #include <numeric>
 
 namespace vr {
-int computeWordDistances(
-    qy::Database const db,
-    std::vector<std::pair<std::string const *, std::string const *>>
-        *variations,
-    DistanceHistogramT *hist) {
+namespace {
+/* Derives an independent seed for each slot (splitmix64). */
+std::uint64_t mixSeed(std::uint64_t const seed, std::size_t const slot) {
+  std::uint64_t z = seed + (std::uint64_t(slot) + 1) * 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+/* Names the file the distances of 'slot' are written into
+ * before the slots are ordered. */
+std::string spoolFile(std::string const &outputDir, std::size_t const slot) {
+  return (std::filesystem::path(outputDir) /
+          ("slot-" + std::to_string(slot) + ".part"))
+      .string();
+}
+} // namespace
+
+int computeWordDistances(qy::Database const db,
+                         std::vector<std::string> const *const words,
+                         DistanceHistogramT *hist,
+                         DistanceOptionsT const &options) {
   if (!db)
     return 1;
-  if (!variations)
+  if (!words)
     return 2;
   if (!hist)
     return 3;
 
+  std::size_t const wordCount = words->size();
+  std::size_t const slotCount = wordCount * wordCount;
+
   std::size_t totalWordCount{};
   qy::getTotalWordCount(db, &totalWordCount);
-  hist->wordPairPtr.clear();
-  hist->wordPairPtr.reserve(variations->size());
-
-  for (auto &pair : *variations) {
-    std::vector<std::size_t> positionsA{}, positionsB{};
-    qy::getWordPositions(db, *pair.first, &positionsA);
-    qy::getWordPositions(db, *pair.second, &positionsB);
-    WordPairInfoT info{};
-    al::computeSinglePairDistances(&positionsA, &positionsB, totalWordCount,
-                                   &info.distances);
-    info.distanceAvg =
-        std::accumulate(info.distances.begin(), info.distances.end(), 0);
-    info.distanceAvg = double(info.distanceAvg) / double(info.distances.size());
-
-    auto pairIt = hist->wordPairInfo.emplace(&pair, std::move(info)).first;
-    hist->wordPairPtr.push_back(pairIt);
+
+  hist->words = words;
+  hist->wordCount = wordCount;
+  hist->distanceAvg.assign(slotCount, 0.0);
+  hist->distanceConfidence.assign(slotCount, 0.0);
+  hist->distanceOffset.assign(slotCount, 0);
+  hist->distanceLength.assign(slotCount, 0);
+  hist->distances.clear();
+  hist->order.resize(slotCount);
+  std::iota(hist->order.begin(), hist->order.end(), std::size_t{});
+
+  // The lists are read in place, from memory or from the mapped spill file.
+  std::vector<std::span<std::size_t const>> positions(wordCount);
+  for (std::size_t i = 0; i < wordCount; ++i)
+    qy::getWordPositionsView(db, (*words)[i], &positions[i]);
+
+  PairCacheT *const cache = options.sampleBudget ? nullptr : options.cache;
+  bool const windowed =
+      options.window.maxDistance || !options.window.wrapAround;
+  std::vector<std::size_t> pairDistances{};
+
+  for (std::size_t i = 0; i < wordCount; ++i) {
+    for (std::size_t j = 0; j < wordCount; ++j) {
+      std::size_t const slot = pairSlot(hist, i, j);
+      auto const &wordA = (*words)[i];
+      auto const &wordB = (*words)[j];
+
+      // The first and last positions alone tell whether the pair can reach
+      // the window, a pruned pair touches neither its lists nor the cache.
+      if (windowed && !al::pairWithinReach(positions[i], positions[j],
+                                           totalWordCount, options.window)) {
+        pairDistances.clear();
+        hist->distanceAvg[slot] = std::nan("");
+      } else if (options.sampleBudget) {
+        al::DistanceSampleT sample{};
+        al::sampleSinglePairDistances(positions[i], positions[j],
+                                      totalWordCount, options.sampleBudget,
+                                      mixSeed(options.seed, slot),
+                                      &pairDistances, &sample, options.window);
+        hist->distanceAvg[slot] = sample.distanceAvg;
+        hist->distanceConfidence[slot] = sample.confidence;
+      } else {
+        if (!findCachedPair(cache, wordA, wordB, &pairDistances)) {
+          if (windowed)
+            al::computeWindowedPairDistances(positions[i], positions[j],
+                                             totalWordCount, options.window,
+                                             &pairDistances);
+          else
+            al::computeSinglePairDistances(positions[i], positions[j],
+                                           totalWordCount, &pairDistances);
+          storeCachedPair(cache, wordA, wordB, pairDistances);
+        }
+
+        auto const sum = std::accumulate(pairDistances.begin(),
+                                         pairDistances.end(), std::size_t{});
+        hist->distanceAvg[slot] = double(sum) / double(pairDistances.size());
+      }
+      hist->distanceOffset[slot] = hist->distances.size();
+      hist->distanceLength[slot] = pairDistances.size();
+      if (options.writer) {
+        if (submitHistogramFile(options.writer,
+                                spoolFile(options.outputDir, slot),
+                                std::move(pairDistances)))
+          return 4;
+        pairDistances = {};
+      } else
+        hist->distances.insert(hist->distances.end(), pairDistances.begin(),
+                               pairDistances.end());
+    }
   }
 
   return 0;
 }
 
+int sortByDistanceAvg(DistanceHistogramT *const hist) {
+  if (!hist)
+    return 1;
+
+  auto const &avg = hist->distanceAvg;
+  std::sort(hist->order.begin(), hist->order.end(),
+            [&avg](std::size_t const a, std::size_t const b) {
+              // Pairs without any distance have a NaN average, keep them last.
+              if (std::isnan(avg[b]))
+                return !std::isnan(avg[a]);
+              return avg[a] < avg[b];
+            });
+  return 0;
+}
+
 int writeHistogramData(DistanceHistogramT const *const hist,
                        std::string const &outputDir,
                        std::size_t const numOfMfw) {
   if (!hist)
     return 1;
-  auto entry = hist->wordPairPtr.begin();
-
-  for (std::size_t i = 0; i < numOfMfw && entry != hist->wordPairPtr.end();
-       ++i) {
-    std::ofstream outstream{std::filesystem::path(outputDir) /
-                            std::filesystem::path(std::to_string(i) + ".txt")};
-    if (!outstream.is_open())
-      return 1;
-
-    for (std::size_t i = 0; i < (*entry)->second.distances.size(); ++i) {
-      outstream << (*entry)->second.distances[i];
-      if (i < (*entry)->second.distances.size() - 1)
-        outstream << "\n";
-    }
-                entry = std::next(entry);
+
+  HistogramWriter writer{};
+  if (auto error = createHistogramWriter(&writer); error)
+    return 1;
+
+  for (std::size_t i = 0; i < numOfMfw && i < hist->order.size(); ++i) {
+    std::size_t const slot = hist->order[i];
+    auto const path = std::filesystem::path(outputDir) /
+                      std::filesystem::path(std::to_string(i) + ".txt");
+    submitHistogramFile(writer, path.string(),
+                        hist->distances.data() + hist->distanceOffset[slot],
+                        hist->distanceLength[slot]);
   }
 
-  return 0;
+  auto const error = finishHistogramWriter(writer);
+  destroyHistogramWriter(writer);
+  return error ? 1 : 0;
+}
+
+int publishHistogramFiles(DistanceHistogramT const *const hist,
+                          std::string const &outputDir,
+                          std::size_t const numOfMfw) {
+  if (!hist)
+    return 1;
+
+  int error{};
+  for (std::size_t i = 0; i < hist->order.size(); ++i) {
+    auto const spooled = spoolFile(outputDir, hist->order[i]);
+    std::error_code status{};
+    if (i < numOfMfw)
+      std::filesystem::rename(spooled,
+                              std::filesystem::path(outputDir) /
+                                  (std::to_string(i) + ".txt"),
+                              status);
+    else
+      std::filesystem::remove(spooled, status);
+    if (status)
+      error = 2;
+  }
+  return error;
 }
 } // namespace vr
@@ -18,30 +18,137 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
 OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
+#pragma once
+
+#include <verbmeter/algo.hpp>
 #include <verbmeter/query.hpp>
-#include <unordered_map>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace vr {
-struct WordPairInfoT {
-  std::vector<std::size_t> distances;
-  double distanceAvg{};
+/* DESCRIPTION:
+ *
+ * Holds the distances of every ordered pair of the K analyzed words.
+ * The pair (i, j) lives in slot i * K + j of each column.
+ * The distances of all the pairs share one buffer, each pair owning
+ * the range [distanceOffset[slot], distanceOffset[slot] + distanceLength[slot]).
+ * The buffer stays empty if the distances were handed to a writer.
+ * The 'order' column lists the slots in the order they are to be output.
+ * The 'distanceConfidence' column holds the half-width of the 95%
+ * confidence interval of each average, it is 0 for exact averages.
+ */
+struct DistanceHistogramT {
+  std::vector<std::string> const *words{};
+  std::size_t wordCount{};
+
+  std::vector<double> distanceAvg{};
+  std::vector<double> distanceConfidence{};
+  std::vector<std::size_t> distanceOffset{};
+  std::vector<std::size_t> distanceLength{};
+  std::vector<std::size_t> distances{};
+
+  std::vector<std::size_t> order{};
 };
 
-struct DistanceHistogramT {
-  using WordPair = std::pair<std::string const *, std::string const *> *;
+inline std::size_t pairSlot(DistanceHistogramT const *const hist,
+                            std::size_t const i, std::size_t const j) {
+  return i * hist->wordCount + j;
+}
+
+struct PairCacheT;
+struct HistogramWriterT;
 
-  std::unordered_map<WordPair, WordPairInfoT> wordPairInfo;
-  std::vector<typename decltype(wordPairInfo)::iterator> wordPairPtr;
+/* DESCRIPTION:
+ *
+ * If 'sampleBudget' is not 0, the distances of each pair are estimated
+ * from at most that many occurrences of its first word instead of
+ * being computed in full. Each pair draws its sample with a seed
+ * derived from 'seed' and its slot, so equal seeds give equal results.
+ *
+ * If 'cache' is not a nullptr, the pairs found in it are not computed,
+ * and the computed pairs are marked to be appended by savePairCache.
+ * The cache must have been opened for the same window.
+ *
+ * Only the distances within 'window' are kept, the pairs that cannot
+ * reach it are pruned before their lists are traversed.
+ *
+ * If 'writer' is not a nullptr, the distances of each pair are handed
+ * to it as soon as they are computed, to be written into a file named
+ * after the slot within 'outputDir', while the next pairs are computed.
+ * The distances are then not kept in the histogram, only their number
+ * is. publishHistogramFiles gives the files their final names.
+ */
+struct DistanceOptionsT {
+  std::size_t sampleBudget{};
+  std::uint64_t seed{};
+  PairCacheT *cache{};
+  al::DistanceWindowT window{};
+  HistogramWriterT *writer{};
+  std::string outputDir{};
 };
 
-int computeWordDistances(
-    qy::Database const db,
-    std::vector<std::pair<std::string const *, std::string const *>> *const
-        variations,
-    DistanceHistogramT *const hist);
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'words' argument is a nullptr.
+ *
+ * 3 - The 'hist' argument is a nullptr.
+ *
+ * 4 - The writer has already been finished.
+ */
+int computeWordDistances(qy::Database const db,
+                         std::vector<std::string> const *const words,
+                         DistanceHistogramT *const hist,
+                         DistanceOptionsT const &options = {});
 
+/* DESCRIPTION:
+ *
+ * Orders the slots by their average distance, shortest first.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'hist' argument is a nullptr.
+ */
+int sortByDistanceAvg(DistanceHistogramT *const hist);
+
+/* DESCRIPTION:
+ *
+ * Writes the distances of the first 'numOfMfw' slots in 'hist->order'
+ * into the files '<index>.txt' within 'outputDir'.
+ * The files are formatted and written on background writer threads.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'hist' argument is a nullptr, or writing a file failed.
+ */
 int writeHistogramData(DistanceHistogramT const *const hist,
                        std::string const &outputDir,
                        std::size_t const numOfMfw);
+
+/* DESCRIPTION:
+ *
+ * Renames the files written for the first 'numOfMfw' slots in
+ * 'hist->order' to '<index>.txt' within 'outputDir' and removes
+ * the files of the other slots. The distances must have been written
+ * by the writer passed to computeWordDistances, which must be finished.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'hist' argument is a nullptr.
+ *
+ * 2 - Renaming or removing a file failed.
+ */
+int publishHistogramFiles(DistanceHistogramT const *const hist,
+                          std::string const &outputDir,
+                          std::size_t const numOfMfw);
 } // namespace vr
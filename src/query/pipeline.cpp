@@ -0,0 +1,210 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "private/query.hpp"
+#include "private/filter.hpp"
+#include "private/ring.hpp"
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+namespace qy {
+namespace {
+constexpr std::size_t blockSize = 1 << 20;
+constexpr std::size_t batchTokenCount = 1 << 14;
+constexpr std::size_t ringCapacity = 8;
+constexpr std::size_t poolSize = ringCapacity + 2;
+
+struct BlockT {
+  std::vector<char> data = std::vector<char>(blockSize);
+  std::size_t size{};
+};
+
+/* The lowercased tokens of a batch are stored back to back in 'text',
+ * 'ends' holds the end offset and 'hashes' the vocabulary hash
+ * of each of them. */
+struct TokenBatchT {
+  std::string text{};
+  std::vector<std::size_t> ends{};
+  std::vector<std::uint64_t> hashes{};
+};
+
+void endToken(TokenBatchT *const batch) {
+  std::size_t const begin = batch->ends.empty() ? 0 : batch->ends.back();
+  batch->hashes.push_back(VocabularyT::hashWord(
+      {batch->text.data() + begin, batch->text.size() - begin}));
+  batch->ends.push_back(batch->text.size());
+}
+
+/* A filled queue between two stages, and the queue that returns the
+ * consumed items back to the producer. A nullptr ends the stream. */
+template <typename T> struct StageLinkT {
+  SpscRingT<T *> filled{ringCapacity};
+  SpscRingT<T *> free{poolSize};
+  std::vector<std::unique_ptr<T>> pool{};
+
+  StageLinkT() {
+    for (std::size_t i = 0; i < poolSize; ++i) {
+      pool.push_back(std::make_unique<T>());
+      free.push(pool.back().get());
+    }
+  }
+};
+
+void readBlocks(std::ifstream *const stream, StageLinkT<BlockT> *const out) {
+  while (true) {
+    BlockT *const block = out->free.pop();
+    stream->read(block->data.data(), std::streamsize(block->data.size()));
+    block->size = std::size_t(stream->gcount());
+    // The free ring belongs to the tokenizer as its producer, the pool
+    // still owns the unused block.
+    if (!block->size) {
+      out->filled.push(nullptr);
+      return;
+    }
+    out->filled.push(block);
+  }
+}
+
+/* Splits the blocks the same way as 'operator>>' in the classic locale
+ * and converts the tokens the same way as toLower(). Hashing the tokens
+ * here takes the work off the indexing thread. */
+void tokenizeBlocks(StageLinkT<BlockT> *const in,
+                    StageLinkT<TokenBatchT> *const out) {
+  TokenBatchT *batch = out->free.pop();
+  batch->text.clear();
+  batch->ends.clear();
+  batch->hashes.clear();
+  bool inToken = false;
+
+  while (BlockT *const block = in->filled.pop()) {
+    for (std::size_t i = 0; i < block->size; ++i) {
+      auto const c = static_cast<unsigned char>(block->data[i]);
+
+      if (!std::isspace(c)) {
+        inToken = true;
+        if (std::isalpha(c))
+          batch->text.push_back(char(std::tolower(c)));
+        continue;
+      }
+      if (!inToken)
+        continue;
+
+      inToken = false;
+      endToken(batch);
+      if (batch->ends.size() == batchTokenCount) {
+        out->filled.push(batch);
+        batch = out->free.pop();
+        batch->text.clear();
+        batch->ends.clear();
+        batch->hashes.clear();
+      }
+    }
+    in->free.push(block);
+  }
+
+  if (inToken)
+    endToken(batch);
+  // The free ring belongs to the indexer as its producer,
+  // an empty batch is left to the pool.
+  if (!batch->ends.empty())
+    out->filled.push(batch);
+  out->filled.push(nullptr);
+}
+
+/* Counts the words and stores their positions in a single pass.
+ * Keeps draining the batches after a failure, so the other stages
+ * can always finish. */
+template <typename Filter>
+int indexBatches(DatabaseT *const db, StageLinkT<TokenBatchT> *const in,
+                 Filter const &filter) {
+  auto const &allowList = db->filter.allowList;
+  bool const trackAllowedOnly = db->filter.allowListPositionsOnly;
+  std::size_t const budgetedPositions = db->memoryBudget / sizeof(std::size_t);
+
+  int error{};
+
+  while (TokenBatchT *const batch = in->filled.pop()) {
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < batch->ends.size() && !error; ++i) {
+      std::string_view const word{batch->text.data() + begin,
+                                  batch->ends[i] - begin};
+      begin = batch->ends[i];
+
+      std::size_t const position = db->totalWordCount++;
+      if (!filter(word))
+        continue;
+
+      auto [info, inserted] = db->wordInfo.findOrInsert(word, batch->hashes[i]);
+      if (inserted) {
+        info->tracked = !trackAllowedOnly || allowList.contains(word);
+        db->sortedUniqueWords.emplace_back(word);
+      }
+
+      ++info->count;
+      if (!info->tracked)
+        continue;
+      if (db->memoryBudget && info->positions.empty())
+        db->bufferedWords.push_back(info->id);
+      info->positions.push_back(position);
+
+      if (db->memoryBudget && ++db->bufferedPositions >= budgetedPositions &&
+          spillPositionRun(db))
+        error = 3;
+    }
+    in->free.push(batch);
+  }
+  return error;
+}
+} // namespace
+
+int ingestPipelined(DatabaseT *const db, std::string const &file) {
+  if (!db)
+    return 1;
+  if (file.empty())
+    return 2;
+
+  std::ifstream stream{file, std::ios::binary};
+  if (!stream.is_open())
+    return 2;
+  db->totalWordCount = 0;
+
+  StageLinkT<BlockT> blocks{};
+  StageLinkT<TokenBatchT> batches{};
+
+  std::thread reader{readBlocks, &stream, &blocks};
+  std::thread tokenizer{tokenizeBlocks, &blocks, &batches};
+
+  int const error = visitTokenFilter(db, [db, &batches](auto const &filter) {
+    return indexBatches(db, &batches, filter);
+  });
+
+  reader.join();
+  tokenizer.join();
+
+  if (error)
+    return error;
+  if (mergePositionRuns(db))
+    return 3;
+  return 0;
+}
+} // namespace qy
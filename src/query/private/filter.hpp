@@ -0,0 +1,114 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "query.hpp"
+#include <functional>
+#include <string_view>
+#include <tuple>
+
+namespace qy {
+/* Each filter returns true for the tokens that are to be indexed. */
+struct StopWordFilterT {
+  WordSetT const *stopWords{};
+
+  bool operator()(std::string_view const token) const {
+    return !stopWords->contains(token);
+  }
+};
+
+struct LengthFilterT {
+  std::size_t minLength{};
+  std::size_t maxLength{};
+
+  bool operator()(std::string_view const token) const {
+    return token.size() >= minLength && token.size() <= maxLength;
+  }
+};
+
+struct AllowListFilterT {
+  WordSetT const *allowList{};
+
+  bool operator()(std::string_view const token) const {
+    return allowList->contains(token);
+  }
+};
+
+struct PredicateFilterT {
+  std::function<bool(std::string_view)> const *predicate{};
+
+  bool operator()(std::string_view const token) const {
+    return (*predicate)(token);
+  }
+};
+
+/* Composes the filters, cheapest first, into a single inlined test.
+ * An empty chain accepts every token. */
+template <typename... Filters> struct FilterChainT {
+  std::tuple<Filters...> filters{};
+
+  bool operator()(std::string_view const token) const {
+    return std::apply(
+        [token](auto const &...filter) { return (filter(token) && ...); },
+        filters);
+  }
+};
+
+/* DESCRIPTION:
+ *
+ * Calls 'visitor' with the filter chain specialized for the filters
+ * configured in the database. Only the configured filters are part of
+ * the chain's type, so the unused ones cost nothing in the hot loop.
+ * Returns what the 'visitor' returns.
+ */
+template <std::size_t Stage = 0, typename Visitor, typename... Filters>
+int visitTokenFilter(DatabaseT const *const db, Visitor &&visitor,
+                     Filters const &...filters) {
+  auto const &config = db->filter;
+
+  if constexpr (Stage == 0) {
+    if (config.minLength || config.maxLength)
+      return visitTokenFilter<1>(
+          db, visitor, filters...,
+          LengthFilterT{config.minLength,
+                        config.maxLength ? config.maxLength
+                                         : std::size_t(-1)});
+    return visitTokenFilter<1>(db, visitor, filters...);
+  } else if constexpr (Stage == 1) {
+    if (!config.stopWords.empty())
+      return visitTokenFilter<2>(db, visitor, filters...,
+                                 StopWordFilterT{&config.stopWords});
+    return visitTokenFilter<2>(db, visitor, filters...);
+  } else if constexpr (Stage == 2) {
+    if (!config.allowList.empty() && !config.allowListPositionsOnly)
+      return visitTokenFilter<3>(db, visitor, filters...,
+                                 AllowListFilterT{&config.allowList});
+    return visitTokenFilter<3>(db, visitor, filters...);
+  } else if constexpr (Stage == 3) {
+    if (config.predicate)
+      return visitTokenFilter<4>(db, visitor, filters...,
+                                 PredicateFilterT{&config.predicate});
+    return visitTokenFilter<4>(db, visitor, filters...);
+  } else {
+    return visitor(FilterChainT<Filters...>{{filters...}});
+  }
+}
+} // namespace qy
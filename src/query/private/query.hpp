@@ -20,20 +20,148 @@ OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #pragma once
 
+#include <verbmeter/query.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace qy {
+/* A range of positions within a spill file, counted in positions. */
+struct SpillSegmentT {
+  std::size_t offset{};
+  std::size_t length{};
+};
+
+/* An unnamed temporary file, unmapped and closed on destruction. */
+struct SpillFileT {
+  int fd{-1};
+  std::size_t length{};
+  std::size_t const *mapping{};
+
+  SpillFileT() = default;
+  SpillFileT(SpillFileT const &) = delete;
+  SpillFileT &operator=(SpillFileT const &) = delete;
+  ~SpillFileT();
+};
+
+/* Allows looking words up by std::string_view without a copy. */
+struct WordHashT {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view const word) const {
+    return std::hash<std::string_view>{}(word);
+  }
+};
+
+using WordSetT = std::unordered_set<std::string, WordHashT, std::equal_to<>>;
+
+/* The validated form of the public TokenFilterT. */
+struct TokenFilterConfigT {
+  WordSetT stopWords{};
+  std::size_t minLength{};
+  std::size_t maxLength{};
+  WordSetT allowList{};
+  bool allowListPositionsOnly{};
+  std::function<bool(std::string_view)> predicate{};
+};
+
 struct WordInfoT {
   std::vector<std::size_t> positions{};
   std::size_t count{};
+  bool tracked{true};
+  /* The index of the word within the vocabulary, in insertion order. */
+  std::uint32_t id{};
+  SpillSegmentT spilled{};
+};
+
+/* DESCRIPTION:
+ *
+ * An insert-only open-addressing hash table of the words.
+ *
+ * The table is split into groups of 16 control bytes, one per slot.
+ * A control byte is either 'emptySlot' or the low 7 bits of the hash
+ * of the word in the slot, so a whole group is matched against a word
+ * at once, with SIMD instructions where available, before any word
+ * is compared. The groups are probed triangularly, starting from
+ * the group selected by the remaining hash bits.
+ *
+ * The slots hold indices into a dense array of entries, kept in
+ * insertion order. The full hash of each entry is stored as well,
+ * so growing the table never hashes a word again. The words are
+ * copied into an arena of large chunks and never move. A word longer
+ * than a chunk gets a buffer of its own.
+ */
+class VocabularyT {
+public:
+  using EntryT = std::pair<std::string_view, WordInfoT>;
+
+  static std::uint64_t hashWord(std::string_view const word);
+
+  /* Returns the info of the word, inserting an empty one if the word
+   * is not present yet, and whether it has been inserted.
+   * The 'hash' must be equal to hashWord(word). */
+  std::pair<WordInfoT *, bool> findOrInsert(std::string_view const word,
+                                            std::uint64_t const hash);
+  std::pair<WordInfoT *, bool> findOrInsert(std::string_view const word);
+
+  WordInfoT *find(std::string_view const word);
+  WordInfoT const *find(std::string_view const word) const;
+  bool contains(std::string_view const word) const;
+
+  /* Throws std::out_of_range if the word is not present. */
+  WordInfoT &at(std::string_view const word);
+  WordInfoT const &at(std::string_view const word) const;
+
+  /* Returns the info of the word whose 'id' is equal to 'index'. */
+  WordInfoT &byId(std::uint32_t const index) { return entries[index].second; }
+
+  std::size_t size() const { return entries.size(); }
+  std::vector<EntryT>::iterator begin() { return entries.begin(); }
+  std::vector<EntryT>::iterator end() { return entries.end(); }
+  std::vector<EntryT>::const_iterator begin() const { return entries.begin(); }
+  std::vector<EntryT>::const_iterator end() const { return entries.end(); }
+
+private:
+  static constexpr std::size_t groupSize = 16;
+  static constexpr std::uint8_t emptySlot = 0x80;
+  static constexpr std::uint32_t notFound = std::uint32_t(-1);
+  static constexpr std::size_t chunkSize = 1 << 16;
+
+  std::uint32_t lookup(std::string_view const word,
+                       std::uint64_t const hash) const;
+  void place(std::uint32_t const index, std::uint64_t const hash);
+  void grow();
+  std::string_view store(std::string_view const word);
+
+  std::vector<std::uint8_t> control{};
+  std::vector<std::uint32_t> slots{};
+  std::vector<EntryT> entries{};
+  std::vector<std::uint64_t> hashes{};
+
+  std::vector<std::unique_ptr<char[]>> chunks{};
+  std::size_t chunkUsed{};
+  std::vector<std::unique_ptr<char[]>> largeWords{};
 };
 
 struct DatabaseT {
-  std::unordered_map<std::string, WordInfoT> wordInfo{};
+  VocabularyT wordInfo{};
   std::vector<std::string> sortedUniqueWords{};
   std::size_t totalWordCount{};
+  TokenFilterConfigT filter{};
+  IngestionE ingestion{IngestionE::Sequential};
+
+  std::size_t memoryBudget{};
+  std::string spillDir{};
+  std::size_t bufferedPositions{};
+  std::vector<std::uint32_t> bufferedWords{};
+  std::vector<SpillSegmentT> runs{};
+  SpillFileT runFile{};
+  SpillFileT mergedFile{};
 };
 } // namespace qy
 
@@ -52,11 +180,22 @@ namespace qy {
  */
 int sortWordsByOccurrence(DatabaseT *const db);
 
+/* DESCRIPTION:
+ *
+ * Lowercases the word and strips it of everything but letters.
+ */
+std::string toLower(std::string const &word);
+
 /* DESCRIPTION:
  *
  * Iterates over each word in a file and
  * stores each position at which it occurs.
  * The time complexity is O(n).
+ * The words rejected by the token filter were never counted, so they are
+ * skipped, as are the words whose positions are not tracked. They still
+ * occupy their positions, so the distances are measured in the original
+ * text. If the database has a memory budget, the positions are spilled
+ * to disk whenever they exceed it, and merged per word at the end.
  * It requires that the countWordOccurrence() method be executed first.
  *
  * EXIT STATUS:
@@ -68,6 +207,8 @@ int sortWordsByOccurrence(DatabaseT *const db);
  * 2 - The 'file' argument does not point to a valid file.
  *
  * 3 - The database has not been initialized.
+ *
+ * 4 - Spilling the positions to disk failed.
  */
 int extractWordPositions(DatabaseT *const db, std::string const &file);
 
@@ -75,6 +216,8 @@ int extractWordPositions(DatabaseT *const db, std::string const &file);
  *
  * Iterates over each word in a file and counts how many times it occurs.
  * The time complexity is O(n).
+ * The words rejected by the token filter are not indexed, though they
+ * are included in the total word count.
  *
  * EXIT STATUS:
  *
@@ -85,4 +228,65 @@ int extractWordPositions(DatabaseT *const db, std::string const &file);
  * 2 - The 'file' argument does not point to a valid file.
  */
 int countWordOccurrence(DatabaseT *const db, std::string const &file);
+
+/* DESCRIPTION:
+ *
+ * Appends the positions held in memory to the run file as a new run
+ * and releases them. Only the words in 'bufferedWords' are visited.
+ * A run is a sequence of records ordered by the word id, each record
+ * being the word id, the number of positions and the sorted positions.
+ * The runs follow each other in the order of the positions they hold.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - Creating or writing the run file failed.
+ */
+int spillPositionRun(DatabaseT *const db);
+
+/* DESCRIPTION:
+ *
+ * Concatenates the runs of each word into a single contiguous list
+ * within the merged file, closes the run file and maps the merged file.
+ * The runs are merged by word id, each read sequentially through its own
+ * buffer, so both files are only ever accessed in order.
+ * Does nothing if no run has been spilled.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - Spilling the remaining positions failed.
+ *
+ * 3 - Creating, writing or mapping the merged file failed.
+ */
+int mergePositionRuns(DatabaseT *const db);
+
+void closeSpillFile(SpillFileT *const file);
+
+/* DESCRIPTION:
+ *
+ * Counts the words of a file and stores their positions in a single pass.
+ * A reader thread reads the file in large blocks, a tokenizer thread
+ * splits and lowercases them into batches of tokens, and the calling
+ * thread indexes the batches. The stages are connected by bounded
+ * single-producer single-consumer queues. The result is the same as
+ * that of countWordOccurrence followed by extractWordPositions.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'db' argument is a nullptr.
+ *
+ * 2 - The 'file' argument does not point to a valid file.
+ *
+ * 3 - Spilling the positions to disk failed.
+ */
+int ingestPipelined(DatabaseT *const db, std::string const &file);
 } // namespace qy
@@ -0,0 +1,103 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace qy {
+/* DESCRIPTION:
+ *
+ * A bounded lock-free queue for exactly one producer and one consumer.
+ * The capacity is rounded up to a power of two. The producer only writes
+ * 'tail' and the consumer only writes 'head', each on its own cache line.
+ * A blocked push or pop spins briefly, then sleeps until the other side
+ * moves its index, so an idle stage does not keep a core busy.
+ */
+template <typename T> class SpscRingT {
+public:
+  explicit SpscRingT(std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+    slots.resize(size);
+    mask = size - 1;
+  }
+
+  bool tryPush(T const &value) {
+    std::size_t const t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == slots.size())
+      return false;
+    slots[t & mask] = value;
+    tail.store(t + 1, std::memory_order_release);
+    tail.notify_one();
+    return true;
+  }
+
+  bool tryPop(T *const value) {
+    std::size_t const h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire))
+      return false;
+    *value = slots[h & mask];
+    head.store(h + 1, std::memory_order_release);
+    head.notify_one();
+    return true;
+  }
+
+  void push(T const &value) {
+    for (std::size_t spin = 0; !tryPush(value); ++spin) {
+      if (spin < spinLimit) {
+        std::this_thread::yield();
+        continue;
+      }
+      // Full, sleep until the consumer moves 'head' past the observed value.
+      std::size_t const t = tail.load(std::memory_order_relaxed);
+      head.wait(t - slots.size(), std::memory_order_acquire);
+    }
+  }
+
+  T pop() {
+    T value{};
+    for (std::size_t spin = 0; !tryPop(&value); ++spin) {
+      if (spin < spinLimit) {
+        std::this_thread::yield();
+        continue;
+      }
+      // Empty, sleep until the producer moves 'tail' past the observed value.
+      tail.wait(head.load(std::memory_order_relaxed),
+                std::memory_order_acquire);
+    }
+    return value;
+  }
+
+private:
+  static constexpr std::size_t cacheLine = 64;
+  static constexpr std::size_t spinLimit = 64;
+
+  std::vector<T> slots{};
+  std::size_t mask{};
+  alignas(cacheLine) std::atomic<std::size_t> head{};
+  alignas(cacheLine) std::atomic<std::size_t> tail{};
+};
+} // namespace qy
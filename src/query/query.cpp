@@ -19,8 +19,10 @@ ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
 OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include "private/query.hpp"
+#include "private/filter.hpp"
 #include <verbmeter/query.hpp>
 #include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <list>
 
@@ -45,11 +47,20 @@ int queryFile(Database const db, std::string const &file) {
   if (!db)
     return 1;
 
-  if (auto error = countWordOccurrence(db, file); error)
-    return 2;
-
-  if (auto error = extractWordPositions(db, file); error)
-    return 3;
+  if (db->ingestion == IngestionE::Pipelined) {
+    if (auto error = ingestPipelined(db, file); error)
+      return error == 3 ? 3 : 2;
+  } else {
+    if (auto error = countWordOccurrence(db, file); error)
+      return 2;
+
+    // No position is tracked, the words have been counted already.
+    bool const countOnly =
+        db->filter.allowListPositionsOnly && db->filter.allowList.empty();
+    if (!countOnly)
+      if (auto error = extractWordPositions(db, file); error)
+        return 3;
+  }
 
   if (auto error = sortWordsByOccurrence(db); error)
     return 4;
@@ -66,6 +77,9 @@ int getWords(Database const db, std::vector<std::string> *const out,
   if (!out)
     return 3;
 
+  if (!count)
+    count = db->sortedUniqueWords.size();
+
   out->reserve(count);
   for (std::size_t i = 0; i < count; ++i)
     out->push_back(db->sortedUniqueWords[i]);
@@ -76,18 +90,105 @@ int getWordPositions(Database const db, std::string const &word,
                      std::vector<std::size_t> *const pos) {
   if (!db)
     return 1;
-  if (!db->wordInfo.contains(word))
+  auto const *const record = db->wordInfo.find(word);
+  if (!record)
     return 2;
   if (!pos)
     return 3;
 
-  auto const &positions = db->wordInfo.at(word).positions;
+  auto const &info = *record;
+  if (db->mergedFile.fd >= 0) {
+    auto const first = db->mergedFile.mapping + info.spilled.offset;
+    pos->assign(first, first + info.spilled.length);
+    return 0;
+  }
+
+  auto const &positions = info.positions;
   pos->resize(positions.size());
   for (std::size_t i = 0; i < positions.size(); ++i)
     pos->at(i) = positions.at(i);
   return 0;
 }
 
+int getWordPositionsView(Database const db, std::string const &word,
+                         std::span<std::size_t const> *const pos) {
+  if (!db)
+    return 1;
+  auto const *const record = db->wordInfo.find(word);
+  if (!record)
+    return 2;
+  if (!pos)
+    return 3;
+
+  if (db->mergedFile.fd >= 0)
+    *pos = {db->mergedFile.mapping + record->spilled.offset,
+            record->spilled.length};
+  else
+    *pos = record->positions;
+  return 0;
+}
+
+int setIngestion(Database const db, IngestionE const ingestion) {
+  if (!db)
+    return 1;
+  db->ingestion = ingestion;
+  return 0;
+}
+
+int setTokenFilter(Database const db, TokenFilterT const &filter) {
+  if (!db)
+    return 1;
+  if (filter.maxLength && filter.minLength > filter.maxLength)
+    return 2;
+
+  auto &config = db->filter;
+  config = {};
+  for (auto const &word : filter.stopWords)
+    config.stopWords.insert(toLower(word));
+  for (auto const &word : filter.allowList)
+    config.allowList.insert(toLower(word));
+  config.minLength = filter.minLength;
+  config.maxLength = filter.maxLength;
+  config.allowListPositionsOnly = filter.allowListPositionsOnly;
+  config.predicate = filter.predicate;
+  return 0;
+}
+
+int setMemoryBudget(Database const db, std::size_t const bytes,
+                    std::string const &tmpDir) {
+  if (!db)
+    return 1;
+  if (!tmpDir.empty() && !std::filesystem::is_directory(tmpDir))
+    return 2;
+
+  db->memoryBudget = bytes;
+  db->spillDir = tmpDir;
+  return 0;
+}
+
+int getMemoryBudget(Database const db, std::size_t *const bytes) {
+  if (!db)
+    return 1;
+  if (!bytes)
+    return 2;
+  *bytes = db->memoryBudget;
+  return 0;
+}
+
+int getWordCount(Database const db, std::string const &word,
+                 std::size_t *const count) {
+  if (!db)
+    return 1;
+  auto const *const record = db->wordInfo.find(word);
+  if (!record)
+    return 2;
+  if (!count)
+    return 3;
+
+  *count = record->count;
+  return 0;
+}
+
 int getTotalWordCount(Database const db, std::size_t *const count) {
   if (!db)
     return 1;
@@ -96,6 +197,15 @@ int getTotalWordCount(Database const db, std::size_t *const count) {
   *count = db->totalWordCount;
   return 0;
 }
+
+int getUniqueWordCount(Database const db, std::size_t *const count) {
+  if (!db)
+    return 1;
+  if (!count)
+    return 2;
+  *count = db->sortedUniqueWords.size();
+  return 0;
+}
 } // namespace qy
 
 // PRIVATE API IMPLEMENTATION
@@ -124,16 +234,11 @@ std::string toLower(std::string const &word) {
   return converted;
 }
 
-int countWordOccurrence(DatabaseT *const db, std::string const &file) {
-  if (!db)
-    return 1;
-  if (file.empty())
-    return 2;
-
-  std::ifstream stream{file};
-  if (!stream.is_open())
-    return 2;
-  db->totalWordCount = 0;
+template <typename Filter>
+int countFilteredWords(DatabaseT *const db, std::istream &stream,
+                       Filter const &filter) {
+  auto const &allowList = db->filter.allowList;
+  bool const trackAllowedOnly = db->filter.allowListPositionsOnly;
 
   std::list<std::string> wordList{};
   std::string currentWord{};
@@ -142,10 +247,13 @@ int countWordOccurrence(DatabaseT *const db, std::string const &file) {
     currentWord = toLower(currentWord);
 
     ++db->totalWordCount;
-    if (db->wordInfo.contains(currentWord))
-      ++db->wordInfo.at(currentWord).count;
-    else {
-      db->wordInfo.emplace(currentWord, WordInfoT{{}, 1});
+    if (!filter(currentWord))
+      continue;
+
+    auto [info, inserted] = db->wordInfo.findOrInsert(currentWord);
+    ++info->count;
+    if (inserted) {
+      info->tracked = !trackAllowedOnly || allowList.contains(currentWord);
       wordList.push_back(std::move(currentWord));
     }
   }
@@ -159,6 +267,22 @@ int countWordOccurrence(DatabaseT *const db, std::string const &file) {
   return 0;
 }
 
+int countWordOccurrence(DatabaseT *const db, std::string const &file) {
+  if (!db)
+    return 1;
+  if (file.empty())
+    return 2;
+
+  std::ifstream stream{file};
+  if (!stream.is_open())
+    return 2;
+  db->totalWordCount = 0;
+
+  return visitTokenFilter(db, [db, &stream](auto const &filter) {
+    return countFilteredWords(db, stream, filter);
+  });
+}
+
 int extractWordPositions(DatabaseT *const db, std::string const &file) {
   if (!db)
     return 1;
@@ -169,18 +293,36 @@ int extractWordPositions(DatabaseT *const db, std::string const &file) {
   if (!stream.is_open())
     return 2;
 
-  for (auto &record : db->wordInfo) {
-    const auto size = record.second.count;
-    record.second.positions.reserve(size);
-  }
+  // With a memory budget the positions are spilled in runs,
+  // reserving the full lists upfront would defeat the budget.
+  if (!db->memoryBudget)
+    for (auto &record : db->wordInfo) {
+      const auto size = record.second.tracked ? record.second.count : 0;
+      record.second.positions.reserve(size);
+    }
 
+  std::size_t const budgetedPositions = db->memoryBudget / sizeof(std::size_t);
   std::size_t position{};
   std::string word{};
 
   while (stream >> word) {
     word = toLower(word);
-    db->wordInfo.at(word).positions.push_back(position++);
+    std::size_t const wordPosition = position++;
+
+    auto *const info = db->wordInfo.find(word);
+    if (!info || !info->tracked)
+      continue;
+    if (db->memoryBudget && info->positions.empty())
+      db->bufferedWords.push_back(info->id);
+    info->positions.push_back(wordPosition);
+
+    if (db->memoryBudget && ++db->bufferedPositions >= budgetedPositions &&
+        spillPositionRun(db))
+      return 4;
   }
+
+  if (mergePositionRuns(db))
+    return 4;
   return 0;
 }
 } // namespace qy
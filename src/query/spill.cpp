@@ -0,0 +1,277 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "private/query.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <queue>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace qy {
+namespace {
+constexpr std::size_t spillBufferLength = (1 << 20) / sizeof(std::size_t);
+constexpr std::size_t minReaderLength = (1 << 14) / sizeof(std::size_t);
+
+int openSpillFile(std::string const &dir, SpillFileT *const file) {
+  auto const base = dir.empty() ? std::filesystem::temp_directory_path()
+                                : std::filesystem::path(dir);
+  std::string path = (base / "verbmeter-XXXXXX").string();
+
+  int const fd = ::mkstemp(path.data());
+  if (fd < 0)
+    return 1;
+  // Only the descriptor is used from now on. Without a name the file
+  // is removed once it is closed, even if the process is killed.
+  ::unlink(path.c_str());
+  file->fd = fd;
+  file->length = 0;
+  return 0;
+}
+
+bool writeFull(int const fd, void const *const data, std::size_t bytes,
+               std::size_t offset) {
+  auto const *cursor = static_cast<char const *>(data);
+  while (bytes) {
+    auto const written = ::pwrite(fd, cursor, bytes, off_t(offset));
+    if (written <= 0)
+      return false;
+    cursor += written;
+    offset += std::size_t(written);
+    bytes -= std::size_t(written);
+  }
+  return true;
+}
+
+bool readFull(int const fd, void *const data, std::size_t bytes,
+              std::size_t offset) {
+  auto *cursor = static_cast<char *>(data);
+  while (bytes) {
+    auto const received = ::pread(fd, cursor, bytes, off_t(offset));
+    if (received <= 0)
+      return false;
+    cursor += received;
+    offset += std::size_t(received);
+    bytes -= std::size_t(received);
+  }
+  return true;
+}
+
+/* Collects positions and appends them to the end of 'file' in large blocks. */
+struct SpillWriterT {
+  SpillFileT *file{};
+  std::vector<std::size_t> buffer{};
+
+  bool append(std::size_t const *positions, std::size_t count) {
+    while (count) {
+      std::size_t const chunk =
+          std::min(count, spillBufferLength - buffer.size());
+      buffer.insert(buffer.end(), positions, positions + chunk);
+      positions += chunk;
+      count -= chunk;
+      if (buffer.size() == spillBufferLength && !flush())
+        return false;
+    }
+    return true;
+  }
+
+  bool flush() {
+    if (!writeFull(file->fd, buffer.data(),
+                   buffer.size() * sizeof(std::size_t),
+                   file->length * sizeof(std::size_t)))
+      return false;
+    file->length += buffer.size();
+    buffer.clear();
+    return true;
+  }
+};
+
+/* Reads the positions [offset, end) of a file in order, in large blocks. */
+struct RunReaderT {
+  int fd{-1};
+  std::size_t offset{};
+  std::size_t end{};
+  std::vector<std::size_t> buffer{};
+  std::size_t cursor{};
+
+  bool done() const { return cursor == buffer.size() && offset == end; }
+
+  bool refill() {
+    std::size_t const count = std::min(buffer.capacity(), end - offset);
+    if (!count)
+      return false;
+    buffer.resize(count);
+    if (!readFull(fd, buffer.data(), count * sizeof(std::size_t),
+                  offset * sizeof(std::size_t)))
+      return false;
+    offset += count;
+    cursor = 0;
+    return true;
+  }
+
+  bool next(std::size_t *const value) {
+    if (cursor == buffer.size() && !refill())
+      return false;
+    *value = buffer[cursor++];
+    return true;
+  }
+
+  /* Appends the next 'count' positions to 'writer'. */
+  bool copy(std::size_t count, SpillWriterT *const writer) {
+    while (count) {
+      if (cursor == buffer.size() && !refill())
+        return false;
+      std::size_t const chunk = std::min(count, buffer.size() - cursor);
+      if (!writer->append(buffer.data() + cursor, chunk))
+        return false;
+      cursor += chunk;
+      count -= chunk;
+    }
+    return true;
+  }
+};
+} // namespace
+
+SpillFileT::~SpillFileT() { closeSpillFile(this); }
+
+void closeSpillFile(SpillFileT *const file) {
+  if (!file)
+    return;
+  if (file->mapping)
+    ::munmap(const_cast<std::size_t *>(file->mapping),
+             file->length * sizeof(std::size_t));
+  if (file->fd >= 0)
+    ::close(file->fd);
+  file->fd = -1;
+  file->length = 0;
+  file->mapping = nullptr;
+}
+
+int spillPositionRun(DatabaseT *const db) {
+  if (!db)
+    return 1;
+
+  if (db->runFile.fd < 0 && openSpillFile(db->spillDir, &db->runFile))
+    return 2;
+
+  SpillWriterT writer{&db->runFile};
+  writer.buffer.reserve(spillBufferLength);
+  std::size_t const runOffset = db->runFile.length;
+
+  auto &words = db->bufferedWords;
+  std::sort(words.begin(), words.end());
+  for (auto const id : words) {
+    auto &positions = db->wordInfo.byId(id).positions;
+    std::size_t const header[2]{id, positions.size()};
+    if (!writer.append(header, 2) ||
+        !writer.append(positions.data(), positions.size()))
+      return 2;
+    std::vector<std::size_t>{}.swap(positions);
+  }
+
+  if (!writer.flush())
+    return 2;
+  if (db->runFile.length > runOffset)
+    db->runs.push_back({runOffset, db->runFile.length - runOffset});
+  words.clear();
+  db->bufferedPositions = 0;
+  return 0;
+}
+
+int mergePositionRuns(DatabaseT *const db) {
+  if (!db)
+    return 1;
+  if (db->runFile.fd < 0)
+    return 0;
+
+  if (spillPositionRun(db))
+    return 2;
+  if (openSpillFile(db->spillDir, &db->mergedFile))
+    return 3;
+
+  SpillWriterT writer{&db->mergedFile};
+  writer.buffer.reserve(spillBufferLength);
+
+  // The readers share about as much memory as the budget allows,
+  // though each gets at least a few pages.
+  std::size_t const runCount = db->runs.size();
+  std::size_t const readerLength =
+      std::clamp(db->memoryBudget / sizeof(std::size_t) /
+                     std::max<std::size_t>(runCount, 1),
+                 minReaderLength, spillBufferLength);
+
+  std::vector<RunReaderT> readers(runCount);
+  using HeadT = std::pair<std::size_t, std::size_t>; // word id, run
+  std::priority_queue<HeadT, std::vector<HeadT>, std::greater<>> heads{};
+  for (std::size_t r = 0; r < runCount; ++r) {
+    readers[r] = {db->runFile.fd, db->runs[r].offset,
+                  db->runs[r].offset + db->runs[r].length};
+    readers[r].buffer.reserve(readerLength);
+    std::size_t id{};
+    if (!readers[r].next(&id))
+      return 3;
+    heads.push({id, r});
+  }
+
+  // Equal ids pop in the order of the runs, so the positions stay sorted.
+  std::size_t currentId = std::size_t(-1);
+  while (!heads.empty()) {
+    auto const [id, r] = heads.top();
+    heads.pop();
+
+    auto &info = db->wordInfo.byId(std::uint32_t(id));
+    if (id != currentId) {
+      info.spilled = {db->mergedFile.length + writer.buffer.size(), 0};
+      currentId = id;
+    }
+
+    std::size_t length{};
+    if (!readers[r].next(&length) || !readers[r].copy(length, &writer))
+      return 3;
+    info.spilled.length += length;
+
+    std::size_t nextId{};
+    if (!readers[r].done()) {
+      if (!readers[r].next(&nextId))
+        return 3;
+      heads.push({nextId, r});
+    }
+  }
+
+  if (!writer.flush())
+    return 3;
+
+  closeSpillFile(&db->runFile);
+  std::vector<SpillSegmentT>{}.swap(db->runs);
+
+  if (db->mergedFile.length) {
+    void *const mapping =
+        ::mmap(nullptr, db->mergedFile.length * sizeof(std::size_t), PROT_READ,
+               MAP_PRIVATE, db->mergedFile.fd, 0);
+    if (mapping == MAP_FAILED)
+      return 3;
+    db->mergedFile.mapping = static_cast<std::size_t const *>(mapping);
+  }
+  return 0;
+}
+} // namespace qy
@@ -0,0 +1,110 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "../private/query.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <verbmeter/query.hpp>
+
+namespace {
+struct RunT {
+  qy::UniqueDatabase db{nullptr, qy::destroyDatabase};
+  double seconds{};
+};
+
+int ingest(std::string const &file, qy::IngestionE const ingestion,
+           RunT *const run) {
+  run->db = qy::createUniqueDatabase();
+  qy::setIngestion(run->db.get(), ingestion);
+
+  auto const start = std::chrono::steady_clock::now();
+  if (auto error = qy::queryFile(run->db.get(), file); error)
+    return error;
+  std::chrono::duration<double> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  run->seconds = elapsed.count();
+  return 0;
+}
+
+bool sameDatabase(qy::DatabaseT const *const a, qy::DatabaseT const *const b) {
+  if (a->totalWordCount != b->totalWordCount ||
+      a->sortedUniqueWords != b->sortedUniqueWords ||
+      a->wordInfo.size() != b->wordInfo.size())
+    return false;
+
+  for (auto const &[word, info] : a->wordInfo) {
+    auto const *const other = b->wordInfo.find(word);
+    if (!other || other->count != info.count ||
+        other->positions != info.positions)
+      return false;
+  }
+  return true;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: <filepath> [<repetitions>]" << std::endl;
+    return 1;
+  }
+
+  std::string const filepath = argv[1];
+  std::size_t repetitions = 3;
+  if (argc == 3) {
+    try {
+      repetitions = std::stoull(argv[2]);
+    } catch (...) {
+      std::cerr << "Failed to convert: '" << argv[2] << "' to a number\n";
+      return 1;
+    }
+  }
+
+  double const megabytes =
+      double(std::filesystem::file_size(filepath)) / double(1 << 20);
+  std::pair<char const *, qy::IngestionE> const modes[] = {
+      {"sequential", qy::IngestionE::Sequential},
+      {"pipelined", qy::IngestionE::Pipelined}};
+
+  RunT last[2]{};
+  for (std::size_t m = 0; m < 2; ++m) {
+    double best{};
+    for (std::size_t r = 0; r < repetitions; ++r) {
+      if (auto error = ingest(filepath, modes[m].second, &last[m]); error) {
+        std::cerr << "Failed to query file with error code: " << error
+                  << std::endl;
+        return 2;
+      }
+      if (!r || last[m].seconds < best)
+        best = last[m].seconds;
+    }
+
+    std::cout << modes[m].first << ": " << best * 1000.0 << "ms, "
+              << megabytes / best << "MiB/s, "
+              << double(last[m].db->totalWordCount) / best / 1e6
+              << "M tokens/s" << std::endl;
+  }
+
+  if (!sameDatabase(last[0].db.get(), last[1].db.get())) {
+    std::cerr << "The ingestion modes produced different databases\n";
+    return 3;
+  }
+  return 0;
+}
@@ -0,0 +1,134 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "../private/query.hpp"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+namespace {
+/* Draws 'tokenCount' tokens from 'vocabularySize' random words
+ * with Zipfian frequencies of exponent 's'. */
+std::vector<std::string> zipfianTokens(std::size_t const vocabularySize,
+                                       std::size_t const tokenCount,
+                                       double const s) {
+  std::mt19937_64 rng{42};
+  std::uniform_int_distribution<int> letter{'a', 'z'};
+  std::uniform_int_distribution<std::size_t> length{2, 12};
+
+  std::vector<std::string> words(vocabularySize);
+  for (auto &word : words) {
+    word.resize(length(rng));
+    for (auto &c : word)
+      c = char(letter(rng));
+  }
+
+  std::vector<double> weights(vocabularySize);
+  for (std::size_t i = 0; i < vocabularySize; ++i)
+    weights[i] = 1.0 / std::pow(double(i + 1), s);
+  std::discrete_distribution<std::size_t> rank{weights.begin(), weights.end()};
+
+  std::vector<std::string> tokens(tokenCount);
+  for (auto &token : tokens)
+    token = words[rank(rng)];
+  return tokens;
+}
+
+/* Words the generator never draws: an empty word, which any token
+ * without letters becomes, and words longer than a vocabulary chunk. */
+std::vector<std::string> edgeTokens() {
+  std::string const longWord(70000, 'x');
+  std::string const longerWord(140000, 'y');
+  return {"", longWord, "ab", "cd", longerWord, longWord, "ab", "", "ef"};
+}
+
+template <typename Index>
+double measure(std::vector<std::string> const &tokens, Index const &index) {
+  auto const start = std::chrono::steady_clock::now();
+  index(tokens);
+  std::chrono::duration<double> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: <vocabulary size> <token count>" << std::endl;
+    return 1;
+  }
+
+  std::size_t vocabularySize{}, tokenCount{};
+  try {
+    vocabularySize = std::stoull(argv[1]);
+    tokenCount = std::stoull(argv[2]);
+  } catch (...) {
+    std::cerr << "Failed to convert the arguments to numbers\n";
+    return 1;
+  }
+  if (!vocabularySize) {
+    std::cerr << "The vocabulary size must be at least 1\n";
+    return 1;
+  }
+
+  auto tokens = edgeTokens();
+  auto const drawn = zipfianTokens(vocabularySize, tokenCount, 1.0);
+  tokens.insert(tokens.end(), drawn.begin(), drawn.end());
+
+  std::unordered_map<std::string, qy::WordInfoT> map{};
+  qy::VocabularyT table{};
+
+  // The lookup pattern the query library used before the vocabulary table.
+  double const mapTime = measure(tokens, [&](auto const &tokens) {
+    for (auto const &token : tokens) {
+      if (map.contains(token))
+        ++map.at(token).count;
+      else
+        map.emplace(token, qy::WordInfoT{{}, 1});
+    }
+  });
+
+  double const tableTime = measure(tokens, [&](auto const &tokens) {
+    for (auto const &token : tokens)
+      ++table.findOrInsert(token).first->count;
+  });
+
+  if (map.size() != table.size()) {
+    std::cerr << "The indices hold different numbers of words\n";
+    return 2;
+  }
+  for (auto const &[word, info] : table) {
+    auto const entry = map.find(std::string{word});
+    if (entry == map.end() || entry->second.count != info.count) {
+      std::cerr << "The indices differ for a word of length: " << word.size()
+                << "\n";
+      return 2;
+    }
+  }
+
+  std::cout << "distinct words: " << table.size() << "\n";
+  std::cout << "std::unordered_map: " << mapTime * 1000.0 << "ms, "
+            << double(tokens.size()) / mapTime / 1e6 << "M tokens/s\n";
+  std::cout << "qy::VocabularyT: " << tableTime * 1000.0 << "ms, "
+            << double(tokens.size()) / tableTime / 1e6 << "M tokens/s\n";
+  return 0;
+}
@@ -0,0 +1,198 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "private/query.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace qy {
+namespace {
+/* Returns a bit mask of the bytes of the 16 byte 'group' equal to 'byte'. */
+std::uint32_t matchByte(std::uint8_t const *const group,
+                        std::uint8_t const byte) {
+#if defined(__SSE2__)
+  auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(group));
+  return std::uint32_t(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(char(byte)))));
+#else
+  std::uint32_t mask{};
+  for (std::size_t i = 0; i < 16; ++i)
+    mask |= std::uint32_t(group[i] == byte) << i;
+  return mask;
+#endif
+}
+
+/* Returns a bit mask of the empty slots of the 16 byte 'group'.
+ * Only the empty slots have the high bit of their control byte set. */
+std::uint32_t matchEmpty(std::uint8_t const *const group) {
+#if defined(__SSE2__)
+  auto const bytes = _mm_loadu_si128(reinterpret_cast<__m128i const *>(group));
+  return std::uint32_t(_mm_movemask_epi8(bytes));
+#else
+  std::uint32_t mask{};
+  for (std::size_t i = 0; i < 16; ++i)
+    mask |= std::uint32_t(group[i] >> 7) << i;
+  return mask;
+#endif
+}
+
+std::size_t firstBit(std::uint32_t const mask) {
+  return std::size_t(__builtin_ctz(mask));
+}
+} // namespace
+
+std::uint64_t VocabularyT::hashWord(std::string_view const word) {
+  // FNV-1a followed by the murmur3 finalizer, which spreads
+  // the entropy of short words over all the bits.
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  for (auto const c : word) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ull;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+std::uint32_t VocabularyT::lookup(std::string_view const word,
+                                  std::uint64_t const hash) const {
+  if (control.empty())
+    return notFound;
+
+  std::size_t const groupMask = control.size() / groupSize - 1;
+  std::uint8_t const tag = std::uint8_t(hash & 0x7f);
+  std::size_t group = std::size_t(hash >> 7) & groupMask;
+
+  for (std::size_t step = 1; step <= groupMask + 1; ++step) {
+    std::uint8_t const *const bytes = control.data() + group * groupSize;
+    for (auto mask = matchByte(bytes, tag); mask; mask &= mask - 1) {
+      auto const index = slots[group * groupSize + firstBit(mask)];
+      if (hashes[index] == hash && entries[index].first == word)
+        return index;
+    }
+    if (matchEmpty(bytes))
+      return notFound;
+    group = (group + step) & groupMask;
+  }
+  return notFound;
+}
+
+void VocabularyT::place(std::uint32_t const index, std::uint64_t const hash) {
+  std::size_t const groupMask = control.size() / groupSize - 1;
+  std::size_t group = std::size_t(hash >> 7) & groupMask;
+
+  // The load factor keeps an empty slot in the table at all times.
+  for (std::size_t step = 1;; ++step) {
+    if (auto mask = matchEmpty(control.data() + group * groupSize); mask) {
+      std::size_t const slot = group * groupSize + firstBit(mask);
+      control[slot] = std::uint8_t(hash & 0x7f);
+      slots[slot] = index;
+      return;
+    }
+    group = (group + step) & groupMask;
+  }
+}
+
+void VocabularyT::grow() {
+  std::size_t const capacity =
+      std::max<std::size_t>(control.size() * 2, groupSize * 16);
+  control.assign(capacity, emptySlot);
+  slots.assign(capacity, notFound);
+
+  for (std::size_t i = 0; i < entries.size(); ++i)
+    place(std::uint32_t(i), hashes[i]);
+}
+
+std::string_view VocabularyT::store(std::string_view const word) {
+  // The oversized words are kept apart, so 'chunks.back()' always
+  // remains the chunk 'chunkUsed' refers to.
+  if (word.size() > chunkSize) {
+    largeWords.push_back(std::make_unique<char[]>(word.size()));
+    std::memcpy(largeWords.back().get(), word.data(), word.size());
+    return {largeWords.back().get(), word.size()};
+  }
+
+  if (chunks.empty() || word.size() > chunkSize - chunkUsed) {
+    chunks.push_back(std::make_unique<char[]>(chunkSize));
+    chunkUsed = 0;
+  }
+
+  char *const copy = chunks.back().get() + chunkUsed;
+  std::memcpy(copy, word.data(), word.size());
+  chunkUsed += word.size();
+  return {copy, word.size()};
+}
+
+std::pair<WordInfoT *, bool>
+VocabularyT::findOrInsert(std::string_view const word,
+                          std::uint64_t const hash) {
+  if (auto const index = lookup(word, hash); index != notFound)
+    return {&entries[index].second, false};
+
+  if ((entries.size() + 1) * 8 > control.size() * 7)
+    grow();
+
+  auto const index = std::uint32_t(entries.size());
+  place(index, hash);
+  entries.emplace_back(store(word), WordInfoT{});
+  entries.back().second.id = index;
+  hashes.push_back(hash);
+  return {&entries.back().second, true};
+}
+
+std::pair<WordInfoT *, bool>
+VocabularyT::findOrInsert(std::string_view const word) {
+  return findOrInsert(word, hashWord(word));
+}
+
+WordInfoT *VocabularyT::find(std::string_view const word) {
+  auto const index = lookup(word, hashWord(word));
+  return index == notFound ? nullptr : &entries[index].second;
+}
+
+WordInfoT const *VocabularyT::find(std::string_view const word) const {
+  auto const index = lookup(word, hashWord(word));
+  return index == notFound ? nullptr : &entries[index].second;
+}
+
+bool VocabularyT::contains(std::string_view const word) const {
+  return find(word);
+}
+
+WordInfoT &VocabularyT::at(std::string_view const word) {
+  if (auto *const info = find(word); info)
+    return *info;
+  throw std::out_of_range{"The word is not present in the vocabulary"};
+}
+
+WordInfoT const &VocabularyT::at(std::string_view const word) const {
+  if (auto const *const info = find(word); info)
+    return *info;
+  throw std::out_of_range{"The word is not present in the vocabulary"};
+}
+} // namespace qy
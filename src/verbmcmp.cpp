@@ -0,0 +1,200 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "compare.hpp"
+#include "histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+/* Runs 'task' once for each document index on all the hardware threads.
+ * Returns the first non-zero error returned by 'task'. */
+template <typename Task>
+int forEachDocument(std::size_t const documentCount, Task const &task) {
+  std::atomic<std::size_t> next{};
+  std::atomic<int> error{};
+
+  auto worker = [&]() {
+    for (std::size_t d = next++; d < documentCount && !error; d = next++)
+      if (auto err = task(d); err) {
+        int expected = 0;
+        error.compare_exchange_strong(expected, err);
+      }
+  };
+
+  std::size_t const threadCount = std::min<std::size_t>(
+      std::max(1u, std::thread::hardware_concurrency()), documentCount);
+  std::vector<std::thread> threads{};
+  for (std::size_t t = 1; t < threadCount; ++t)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &thread : threads)
+    thread.join();
+
+  return error;
+}
+
+int writeMatrix(std::vector<std::string> const &documents,
+                std::vector<double> const &matrix, std::ostream &out) {
+  std::size_t const n = documents.size();
+  for (std::size_t i = 0; i < n; ++i)
+    out << "\t" << documents[i];
+  out << "\n";
+
+  for (std::size_t i = 0; i < n; ++i) {
+    out << documents[i];
+    for (std::size_t j = 0; j < n; ++j)
+      out << "\t" << matrix[i * n + j];
+    out << "\n";
+  }
+  return out ? 0 : 1;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 6) {
+    std::cerr << "Usage: <output file> <number of most freq words> "
+                 "<cosine|delta|euclidean> <input file> <input file> "
+                 "[<input file>]...";
+    return 1;
+  }
+
+  std::string const outputFile{argv[1]};
+  std::string const metricName{argv[3]};
+  std::vector<std::string> const documents(argv + 4, argv + argc);
+  std::size_t numOfMfw{};
+
+  try {
+    numOfMfw = std::stoull(argv[2]);
+  } catch (...) {
+    std::cerr << "Failed to convert: '" << argv[2] << "' to a number\n";
+    return 1;
+  }
+  if (numOfMfw < 2) {
+    std::cerr << "The number of most frequent words must be at least 2\n";
+    return 1;
+  }
+
+  vr::MetricE metric{};
+  if (metricName == "cosine")
+    metric = vr::MetricE::Cosine;
+  else if (metricName == "delta")
+    metric = vr::MetricE::Delta;
+  else if (metricName == "euclidean")
+    metric = vr::MetricE::Euclidean;
+  else {
+    std::cerr << "Unknown metric: '" << metricName << "'\n";
+    return 1;
+  }
+
+  for (auto const &document : documents)
+    if (!std::filesystem::exists(document)) {
+      std::cerr << "The input file: '" << document << "' does not exist\n";
+      return 1;
+    }
+
+  // The shared vocabulary consists of the words
+  // with the highest summed relative frequency.
+  // Only the counts are needed, so no positions are tracked.
+  std::mutex frequencyMutex{};
+  std::unordered_map<std::string, double> frequency{};
+  qy::TokenFilterT countOnly{};
+  countOnly.allowListPositionsOnly = true;
+
+  auto error = forEachDocument(documents.size(), [&](std::size_t const d) {
+    auto dbPtr = qy::createUniqueDatabase();
+    if (qy::setTokenFilter(dbPtr.get(), countOnly) ||
+        qy::queryFile(dbPtr.get(), documents[d]))
+      return 1;
+
+    std::size_t totalWordCount{};
+    std::vector<std::string> words{};
+    qy::getTotalWordCount(dbPtr.get(), &totalWordCount);
+    qy::getWords(dbPtr.get(), &words);
+
+    std::lock_guard lock{frequencyMutex};
+    for (auto const &word : words) {
+      std::size_t count{};
+      qy::getWordCount(dbPtr.get(), word, &count);
+      frequency[word] += double(count) / double(totalWordCount);
+    }
+    return 0;
+  });
+  if (error) {
+    std::cerr << "Failed to query the input files\n";
+    return 1;
+  }
+
+  std::vector<std::pair<std::string, double>> ranked(frequency.begin(),
+                                                     frequency.end());
+  std::sort(ranked.begin(), ranked.end(), [](auto const &a, auto const &b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+  });
+  if (ranked.size() < numOfMfw) {
+    std::cerr << "The input files contain only " << ranked.size()
+              << " distinct words\n";
+    return 1;
+  }
+
+  std::vector<std::string> vocabulary(numOfMfw);
+  for (std::size_t i = 0; i < numOfMfw; ++i)
+    vocabulary[i] = ranked[i].first;
+
+  vr::SignatureMatrixT signatures{};
+  vr::createSignatureMatrix(documents.size(), numOfMfw * numOfMfw,
+                            &signatures);
+
+  error = forEachDocument(documents.size(), [&](std::size_t const d) {
+    auto dbPtr = qy::createUniqueDatabase();
+    if (qy::queryFile(dbPtr.get(), documents[d]))
+      return 1;
+
+    std::size_t totalWordCount{};
+    qy::getTotalWordCount(dbPtr.get(), &totalWordCount);
+
+    vr::DistanceHistogramT histogram{};
+    if (vr::computeWordDistances(dbPtr.get(), &vocabulary, &histogram))
+      return 2;
+    if (vr::fillSignature(&histogram, totalWordCount, d, &signatures))
+      return 3;
+    return 0;
+  });
+  if (error) {
+    std::cerr << "Failed to compute the signatures with error code: " << error
+              << std::endl;
+    return 1;
+  }
+
+  std::vector<double> matrix{};
+  vr::computeDistanceMatrix(&signatures, metric, 0, &matrix);
+
+  std::ofstream out{outputFile};
+  if (!out.is_open() || writeMatrix(documents, matrix, out)) {
+    std::cerr << "Writing the matrix file: '" << outputFile << "' failed\n";
+    return 1;
+  }
+  return 0;
+}
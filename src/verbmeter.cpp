@@ -19,23 +19,79 @@ ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
 OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
 
 #include <filesystem>
-#include <verbmeter/algo.hpp>
 #include "histogram.hpp"
+#include "cache.hpp"
+#include "writer.hpp"
 #include <algorithm>
 #include <iostream>
 #include <fstream>
 
 namespace vr {
-int writeMappingFile(DistanceHistogramT const *const hist, std::ostream &out);
-}
+/* DESCRIPTION:
+ *
+ * Writes the word pair of each output file. In preview mode each line
+ * also holds the estimated average and its 95% confidence half-width.
+ */
+int writeMappingFile(DistanceHistogramT const *const hist, std::ostream &out,
+                     bool const preview);
+
+struct OptionsT {
+  std::size_t memoryBudget{};
+  std::string tmpDir{};
+  std::string cacheDir{};
+  qy::TokenFilterT filter{};
+  qy::IngestionE ingestion{qy::IngestionE::Sequential};
+  DistanceOptionsT distance{};
+};
+
+/* EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'file' argument could not be read.
+ *
+ * 2 - The 'words' argument is a nullptr.
+ */
+int readWordList(std::string const &file, std::vector<std::string> *const words);
+
+/* DESCRIPTION:
+ *
+ * Names the cache variant of the options. The distance window changes the
+ * distances of the pairs, as does tracking the positions of the allowed
+ * words only. Filtering out words merely removes their pairs.
+ */
+std::string cacheVariant(OptionsT const &options);
+
+/* DESCRIPTION:
+ *
+ * Parses the optional arguments that follow the positional ones.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - An argument is unknown, lacks its value or its value is invalid.
+ */
+int parseOptions(int const argc, char **argv, OptionsT *const options);
+} // namespace vr
 
 int main(int argc, char **argv) {
   if (argc < 4) {
     std::cerr
-        << "Usage: <input file> <output dir path> <number of most freq words>";
+        << "Usage: <input file> <output dir path> <number of most freq words> "
+           "[--memory-budget <MiB>] [--tmp-dir <dir>] "
+           "[--preview <sample budget>] [--seed <number>] [--cache <dir>] "
+           "[--stop-words <file>] [--min-length <number>] "
+           "[--max-length <number>] [--allow-list <file>] [--track-only <file>] "
+           "[--ingestion <sequential|pipelined>] [--max-distance <number>] "
+           "[--wrap-around <yes|no>]";
     return 1;
   }
 
+  vr::OptionsT options{};
+  if (auto error = vr::parseOptions(argc - 4, argv + 4, &options); error)
+    return 1;
+
   std::string const inputFile{argv[1]};
   std::string const outputDir{argv[2]};
   std::size_t numOfMfw{};
@@ -64,6 +120,20 @@ int main(int argc, char **argv) {
   auto dbPtr = qy::createUniqueDatabase();
   qy::Database const db = dbPtr.get();
 
+  if (auto error =
+          qy::setMemoryBudget(db, options.memoryBudget, options.tmpDir);
+      error) {
+    std::cerr << "The temporary dir: '" << options.tmpDir
+              << "' does not exist\n";
+    return 1;
+  }
+
+  if (auto error = qy::setTokenFilter(db, options.filter); error) {
+    std::cerr << "The minimum length is greater than the maximum length\n";
+    return 1;
+  }
+
+  qy::setIngestion(db, options.ingestion);
   if (auto error = qy::queryFile(db, inputFile); error) {
     std::cerr << "Failed to query file with error code: " << error << std::endl;
     return 1;
@@ -75,49 +145,184 @@ int main(int argc, char **argv) {
     return 1;
   }
 
-  std::vector<std::pair<std::string const *, std::string const *>> variations{};
-  if (auto error = al::gen2ElementVariations(mostFrequentWords, &variations);
-      error) {
-    std::cerr << "Failed to get variations with error code: " << error
-              << std::endl;
+  vr::PairCacheT cache{};
+  if (!options.cacheDir.empty() && !options.distance.sampleBudget) {
+    if (auto error = vr::openPairCache(options.cacheDir, inputFile,
+                                       vr::cacheVariant(options), &cache);
+        error) {
+      std::cerr << "Failed to open the pair cache with error code: " << error
+                << std::endl;
+      return 1;
+    }
+    options.distance.cache = &cache;
+  }
+
+  // The pairs are written out while the next ones are computed,
+  // and only get their final names once they are ordered.
+  vr::HistogramWriter writer{};
+  if (auto error = vr::createHistogramWriter(&writer); error) {
+    std::cerr << "Failed to start the histogram writer" << std::endl;
     return 1;
   }
+  options.distance.writer = writer;
+  options.distance.outputDir = outputDir;
 
   vr::DistanceHistogramT histogram{};
-  if (auto error = vr::computeWordDistances(db, &variations, &histogram);
-      error) {
-    std::cerr << "Failed to compute distances with error code: " << error
-              << std::endl;
+  auto const computeError = vr::computeWordDistances(
+      db, &mostFrequentWords, &histogram, options.distance);
+  auto const writeError = vr::finishHistogramWriter(writer);
+  vr::destroyHistogramWriter(writer);
+  if (computeError || writeError)
+    vr::publishHistogramFiles(&histogram, outputDir, 0);
+  if (computeError) {
+    std::cerr << "Failed to compute distances with error code: "
+              << computeError << std::endl;
+    return 1;
+  }
+  if (writeError) {
+    std::cerr << "Writing histogram data failed!" << std::endl;
     return 1;
   }
 
-  std::sort(histogram.wordPairPtr.begin(), histogram.wordPairPtr.end(),
-            [](auto const &a, auto const &b) {
-              return a->second.distanceAvg < b->second.distanceAvg;
-            });
+  if (options.distance.cache) {
+    std::size_t const lookups = cache.hits + cache.misses;
+    std::cout << "Pair cache hits: " << cache.hits << "/" << lookups << " ("
+              << (lookups ? 100.0 * double(cache.hits) / double(lookups) : 0.0)
+              << "%)" << std::endl;
+    if (auto error = vr::savePairCache(&cache); error)
+      std::cerr << "Failed to save the pair cache: '" << cache.file << "'\n";
+  }
+
+  vr::sortByDistanceAvg(&histogram);
 
   std::ofstream mapping{std::filesystem::path(outputDir) /
                         std::filesystem::path("mapping.txt")};
-  if (auto error = writeMappingFile(&histogram, mapping); error) {
+  if (auto error =
+          writeMappingFile(&histogram, mapping, options.distance.sampleBudget);
+      error) {
     std::cerr << "Writing mapping file failed!" << std::endl;
     return 1;
   }
 
-  vr::writeHistogramData(&histogram, outputDir, numOfMfw);
+  if (auto error = vr::publishHistogramFiles(&histogram, outputDir, numOfMfw);
+      error) {
+    std::cerr << "Writing histogram data failed!" << std::endl;
+    return 1;
+  }
   return 0;
 }
 
 namespace vr {
-int writeMappingFile(DistanceHistogramT const *const hist, std::ostream &out) {
-  std::size_t index = 0;
+int writeMappingFile(DistanceHistogramT const *const hist, std::ostream &out,
+                     bool const preview) {
+  auto const &words = *hist->words;
+
+  for (std::size_t index = 0; index < hist->order.size(); ++index) {
+    std::size_t const slot = hist->order[index];
+    out << index << "\t" << words[slot / hist->wordCount] << " "
+        << words[slot % hist->wordCount];
+    if (preview)
+      out << "\t" << hist->distanceAvg[slot] << "\t"
+          << hist->distanceConfidence[slot];
+    out << "\n";
+  }
+
+  return 0;
+}
+
+int parseOptions(int const argc, char **argv, OptionsT *const options) {
+  for (int i = 0; i < argc; ++i) {
+    std::string const name{argv[i]};
+    if (i + 1 >= argc) {
+      std::cerr << "The option: '" << name << "' requires a value\n";
+      return 1;
+    }
+    std::string const value{argv[++i]};
 
-  for (auto entry = hist->wordPairPtr.begin(); entry != hist->wordPairPtr.end();
-       ++entry) {
-    auto const &[pair, info] = *(*entry);
-    out << index << "\t" << (*pair->first) << " " << (*pair->second) << "\n";
-    ++index;
+    try {
+      if (name == "--memory-budget")
+        options->memoryBudget = std::stoull(value) << 20;
+      else if (name == "--tmp-dir")
+        options->tmpDir = value;
+      else if (name == "--preview")
+        options->distance.sampleBudget = std::stoull(value);
+      else if (name == "--seed")
+        options->distance.seed = std::stoull(value);
+      else if (name == "--cache")
+        options->cacheDir = value;
+      else if (name == "--max-distance")
+        options->distance.window.maxDistance = std::stoull(value);
+      else if (name == "--wrap-around") {
+        if (value != "yes" && value != "no") {
+          std::cerr << "The option: '" << name << "' takes yes or no\n";
+          return 1;
+        }
+        options->distance.window.wrapAround = value == "yes";
+      } else if (name == "--ingestion") {
+        if (value != "sequential" && value != "pipelined") {
+          std::cerr << "Unknown ingestion: '" << value << "'\n";
+          return 1;
+        }
+        options->ingestion = value == "pipelined"
+                                 ? qy::IngestionE::Pipelined
+                                 : qy::IngestionE::Sequential;
+      } else if (name == "--min-length")
+        options->filter.minLength = std::stoull(value);
+      else if (name == "--max-length")
+        options->filter.maxLength = std::stoull(value);
+      else if (name == "--stop-words" || name == "--allow-list" ||
+               name == "--track-only") {
+        auto *const words = name == "--stop-words" ? &options->filter.stopWords
+                                                   : &options->filter.allowList;
+        if (readWordList(value, words)) {
+          std::cerr << "Failed to read the word list: '" << value << "'\n";
+          return 1;
+        }
+        if (name == "--track-only")
+          options->filter.allowListPositionsOnly = true;
+      } else {
+        std::cerr << "Unknown option: '" << name << "'\n";
+        return 1;
+      }
+    } catch (...) {
+      std::cerr << "Failed to convert: '" << value << "' to a number\n";
+      return 1;
+    }
   }
+  return 0;
+}
+
+int readWordList(std::string const &file,
+                 std::vector<std::string> *const words) {
+  std::ifstream stream{file};
+  if (!stream.is_open())
+    return 1;
+  if (!words)
+    return 2;
 
+  std::string word{};
+  while (stream >> word)
+    words->push_back(std::move(word));
   return 0;
 }
+
+std::string cacheVariant(OptionsT const &options) {
+  std::string variant{};
+  auto const &window = options.distance.window;
+  if (window.maxDistance)
+    variant += "max" + std::to_string(window.maxDistance);
+  if (!window.wrapAround)
+    variant += "nowrap";
+
+  auto const &filter = options.filter;
+  if (!filter.allowListPositionsOnly)
+    return variant;
+
+  auto words = filter.allowList;
+  std::sort(words.begin(), words.end());
+  std::string joined{};
+  for (auto const &word : words)
+    joined += word + "\n";
+  return variant + "tracked" + std::to_string(hashBytes(joined));
+}
 } // namespace vr
@@ -0,0 +1,180 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "writer.hpp"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vr {
+namespace {
+constexpr std::size_t writeBufferSize = 1 << 20;
+
+/* Moving a job keeps 'first' valid, the buffer of 'owned' does not move. */
+struct WriteJobT {
+  std::string file{};
+  std::size_t const *first{};
+  std::size_t length{};
+  std::vector<std::size_t> owned{};
+};
+} // namespace
+
+struct HistogramWriterT {
+  std::mutex mutex{};
+  std::condition_variable notEmpty{};
+  std::condition_variable notFull{};
+  std::deque<WriteJobT> queue{};
+  std::size_t queueCapacity{};
+  bool finished{};
+  bool failed{};
+  std::vector<std::thread> threads{};
+};
+
+namespace {
+bool writeJob(WriteJobT const &job, std::vector<char> *const buffer) {
+  std::ofstream outstream{job.file, std::ios::binary};
+  if (!outstream.is_open())
+    return false;
+
+  // Leaves room for the longest number and its separator.
+  constexpr std::size_t reserve = 24;
+  char *const begin = buffer->data();
+  char *const end = begin + buffer->size() - reserve;
+  char *cursor = begin;
+
+  for (std::size_t i = 0; i < job.length; ++i) {
+    if (i)
+      *cursor++ = '\n';
+    cursor = std::to_chars(cursor, cursor + reserve, job.first[i]).ptr;
+
+    if (cursor >= end) {
+      outstream.write(begin, cursor - begin);
+      cursor = begin;
+    }
+  }
+
+  outstream.write(begin, cursor - begin);
+  return bool(outstream);
+}
+
+void writerLoop(HistogramWriterT *const writer) {
+  std::vector<char> buffer(writeBufferSize);
+
+  while (true) {
+    WriteJobT job{};
+    {
+      std::unique_lock lock{writer->mutex};
+      writer->notEmpty.wait(lock, [writer] {
+        return !writer->queue.empty() || writer->finished;
+      });
+      if (writer->queue.empty())
+        return;
+      job = std::move(writer->queue.front());
+      writer->queue.pop_front();
+    }
+    writer->notFull.notify_one();
+
+    if (!writeJob(job, &buffer)) {
+      std::lock_guard lock{writer->mutex};
+      writer->failed = true;
+    }
+  }
+}
+} // namespace
+
+int createHistogramWriter(HistogramWriter *const writer,
+                          std::size_t threadCount,
+                          std::size_t const queueCapacity) {
+  if (!writer)
+    return 1;
+  if (!queueCapacity)
+    return 2;
+
+  if (!threadCount)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  *writer = new HistogramWriterT{};
+  (*writer)->queueCapacity = queueCapacity;
+  (*writer)->threads.reserve(threadCount);
+  for (std::size_t i = 0; i < threadCount; ++i)
+    (*writer)->threads.emplace_back(writerLoop, *writer);
+  return 0;
+}
+
+namespace {
+int submitJob(HistogramWriter const writer, WriteJobT job) {
+  if (!writer)
+    return 1;
+
+  {
+    std::unique_lock lock{writer->mutex};
+    if (writer->finished)
+      return 2;
+    writer->notFull.wait(lock, [writer] {
+      return writer->queue.size() < writer->queueCapacity;
+    });
+    writer->queue.push_back(std::move(job));
+  }
+  writer->notEmpty.notify_one();
+  return 0;
+}
+} // namespace
+
+int submitHistogramFile(HistogramWriter const writer, std::string file,
+                        std::size_t const *const first,
+                        std::size_t const length) {
+  return submitJob(writer, {std::move(file), first, length});
+}
+
+int submitHistogramFile(HistogramWriter const writer, std::string file,
+                        std::vector<std::size_t> distances) {
+  WriteJobT job{std::move(file), distances.data(), distances.size(),
+                std::move(distances)};
+  return submitJob(writer, std::move(job));
+}
+
+int finishHistogramWriter(HistogramWriter const writer) {
+  if (!writer)
+    return 1;
+
+  {
+    std::lock_guard lock{writer->mutex};
+    writer->finished = true;
+  }
+  writer->notEmpty.notify_all();
+
+  for (auto &thread : writer->threads)
+    if (thread.joinable())
+      thread.join();
+
+  return writer->failed ? 2 : 0;
+}
+
+void destroyHistogramWriter(HistogramWriter const writer) {
+  if (writer)
+    finishHistogramWriter(writer);
+  delete writer;
+}
+} // namespace vr
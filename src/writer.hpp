@@ -0,0 +1,101 @@
+/* Copyright (c) 2025 unixdev73@gmail.com
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"),
+to deal in the Software without restriction, including without limitation
+the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software
+is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vr {
+struct HistogramWriterT;
+using HistogramWriter = HistogramWriterT *;
+
+/* DESCRIPTION:
+ *
+ * Starts 'threadCount' background threads that write the submitted
+ * distance lists into files. At most 'queueCapacity' submitted lists
+ * may wait to be written, further submissions block until a slot frees up.
+ * If 'threadCount' is equal to 0, the hardware concurrency is used.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'writer' argument is a nullptr.
+ *
+ * 2 - The 'queueCapacity' argument is equal to 0.
+ */
+int createHistogramWriter(HistogramWriter *const writer,
+                          std::size_t threadCount = 0,
+                          std::size_t const queueCapacity = 64);
+
+/* DESCRIPTION:
+ *
+ * Queues 'length' distances starting at 'first' to be written into 'file',
+ * one per line. The distances must stay alive until the writer is finished.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'writer' argument is a nullptr.
+ *
+ * 2 - The writer has already been finished.
+ */
+int submitHistogramFile(HistogramWriter const writer, std::string file,
+                        std::size_t const *const first,
+                        std::size_t const length);
+
+/* DESCRIPTION:
+ *
+ * Queues 'distances' to be written into 'file', one per line.
+ * The writer owns the distances and releases them once they are written,
+ * so a caller producing them one list at a time holds at most
+ * the queued lists in memory.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'writer' argument is a nullptr.
+ *
+ * 2 - The writer has already been finished.
+ */
+int submitHistogramFile(HistogramWriter const writer, std::string file,
+                        std::vector<std::size_t> distances);
+
+/* DESCRIPTION:
+ *
+ * Waits until every submitted file has been written
+ * and stops the background threads.
+ *
+ * EXIT STATUS:
+ *
+ * 0 - The operation was successful.
+ *
+ * 1 - The 'writer' argument is a nullptr.
+ *
+ * 2 - At least one of the files could not be written.
+ */
+int finishHistogramWriter(HistogramWriter const writer);
+
+void destroyHistogramWriter(HistogramWriter const writer);
+} // namespace vr